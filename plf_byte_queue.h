@@ -0,0 +1,405 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_BYTE_QUEUE_H
+#define PLF_BYTE_QUEUE_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_BYTE_QUEUE_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <cstring> // std::memcpy
+#include <utility> // std::swap
+
+#include "plf_queue_group_chain.h"
+
+
+
+namespace plf
+{
+
+
+// A view of a stored record's payload:
+struct byte_span
+{
+	unsigned char *	record_data;
+	std::size_t			record_size;
+
+	unsigned char * data() const PLF_NOEXCEPT { return record_data; }
+	std::size_t size() const PLF_NOEXCEPT { return record_size; }
+	bool empty() const PLF_NOEXCEPT { return record_size == 0; }
+	unsigned char * begin() const PLF_NOEXCEPT { return record_data; }
+	unsigned char * end() const PLF_NOEXCEPT { return record_data + record_size; }
+};
+
+
+
+// plf::byte_queue is a FIFO queue of variable-length byte records (eg. serialized messages), stored contiguously and length-prefixed within byte-sized groups, so there is no per-record allocation.
+// Group chain and group recycling behaviour matches plf::queue, though groups are always allocated with plain operator new and grow as per plf::memory_use (see plf::group_chain), with block capacities measured in bytes. A record which does not fit in the remainder of the current group rolls over to the next group, which is made large enough to hold it if necessary.
+// Record payloads are aligned to sizeof(std::size_t).
+
+class byte_queue : private plf::group_chain<plf::byte_group<sizeof(std::size_t)> >
+{
+public:
+	typedef std::size_t	size_type;
+
+private:
+	typedef plf::byte_group<sizeof(std::size_t)>	group;
+	typedef plf::group_chain<group>					chain_type;
+
+	static const size_type header_size = sizeof(size_type); // Length prefix. Also the record alignment
+
+	size_type		start_offset, top_offset, back_offset; // offsets of the front record within first_group, one-past the back record within current_group, and of the back record within current_group
+	size_type		total_bytes; // the number of bytes used by records, including length prefixes and padding
+
+
+
+	static size_type record_footprint(const size_type size) PLF_NOEXCEPT
+	{
+		return header_size + ((size + (header_size - 1)) & ~(header_size - 1));
+	}
+
+
+
+	void progress_to_next_group(const size_type footprint) // used by emplace when the record does not fit in the current group
+	{
+		current_group->used = top_offset;
+		chain_type::progress_to_next_group(total_bytes, footprint);
+		current_group->used = 0;
+		top_offset = 0;
+	}
+
+
+
+	void copy_from_source(const byte_queue &source)
+	{
+		if (source.total_size == 0) return;
+
+		group *current = source.first_group;
+		size_type offset = source.start_offset;
+
+		for (size_type remaining = source.total_size; remaining != 0; --remaining)
+		{
+			if (current != source.current_group && offset == current->used)
+			{
+				current = current->next_group;
+				offset = 0;
+			}
+
+			size_type size;
+			std::memcpy(static_cast<void *>(&size), current->data() + offset, header_size);
+			push(current->data() + offset + header_size, size);
+			offset += record_footprint(size);
+		}
+	}
+
+
+
+	void destroy_all_data() PLF_NOEXCEPT
+	{
+		deallocate_all_groups();
+		blank();
+	}
+
+
+
+	void blank() PLF_NOEXCEPT
+	{
+		current_group = first_group = NULL;
+		start_offset = top_offset = back_offset = total_size = total_bytes = total_capacity = 0;
+	}
+
+
+
+public:
+
+	static PLF_CONSTFUNC size_type default_min_block_capacity() PLF_NOEXCEPT
+	{
+		return 1024;
+	}
+
+
+
+	static PLF_CONSTFUNC size_type default_max_block_capacity() PLF_NOEXCEPT
+	{
+		return 65536;
+	}
+
+
+
+	byte_queue() PLF_NOEXCEPT:
+		chain_type(default_min_block_capacity(), default_max_block_capacity()),
+		start_offset(0),
+		top_offset(0),
+		back_offset(0),
+		total_bytes(0)
+	{}
+
+
+
+	// Constructor with limits, in bytes:
+	byte_queue(const size_type min, const size_type max = default_max_block_capacity()):
+		chain_type(min, max),
+		start_offset(0),
+		top_offset(0),
+		back_offset(0),
+		total_bytes(0)
+	{
+		check_capacities_conformance(min, max, header_size * 2);
+	}
+
+
+
+	byte_queue(const byte_queue &source):
+		chain_type(source.min_block_capacity, source.max_block_capacity),
+		start_offset(0),
+		top_offset(0),
+		back_offset(0),
+		total_bytes(0)
+	{
+		copy_from_source(source);
+	}
+
+
+
+	#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+		byte_queue(byte_queue &&source) PLF_NOEXCEPT:
+			chain_type(source.min_block_capacity, source.max_block_capacity),
+			start_offset(0),
+			top_offset(0),
+			back_offset(0),
+			total_bytes(0)
+		{
+			swap(source);
+		}
+
+
+
+		byte_queue & operator = (byte_queue &&source) PLF_NOEXCEPT
+		{
+			assert(&source != this);
+
+			destroy_all_data();
+			swap(source);
+			return *this;
+		}
+	#endif
+
+
+
+	byte_queue & operator = (const byte_queue &source)
+	{
+		assert(&source != this);
+
+		byte_queue temp(source);
+		swap(temp);
+		return *this;
+	}
+
+
+
+	~byte_queue() PLF_NOEXCEPT
+	{
+		destroy_all_data();
+	}
+
+
+
+	// Appends a record of the given size and returns a pointer to it's (uninitialized) payload, for the caller to write into:
+	unsigned char * emplace(const size_type size)
+	{
+		const size_type footprint = record_footprint(size);
+
+		if (current_group == NULL)
+		{
+			initialize(footprint);
+		}
+		else if (current_group->capacity - top_offset < footprint) // ie. record does not fit in the remainder of the current group
+		{
+			progress_to_next_group(footprint);
+		}
+
+		unsigned char * const record = current_group->data() + top_offset;
+		std::memcpy(static_cast<void *>(record), static_cast<const void *>(&size), header_size);
+		back_offset = top_offset;
+		top_offset += footprint;
+		total_bytes += footprint;
+		++total_size;
+		return record + header_size;
+	}
+
+
+
+	void push(const void * const data, const size_type size)
+	{
+		std::memcpy(static_cast<void *>(emplace(size)), data, size);
+	}
+
+
+
+	byte_span front() const PLF_NOEXCEPT // Undefined behaviour if queue is empty
+	{
+		assert(total_size != 0);
+		unsigned char * const record = first_group->data() + start_offset;
+		byte_span span = {record + header_size, 0};
+		std::memcpy(static_cast<void *>(&span.record_size), static_cast<const void *>(record), header_size);
+		return span;
+	}
+
+
+
+	byte_span back() const PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+		unsigned char * const record = current_group->data() + back_offset;
+		byte_span span = {record + header_size, 0};
+		std::memcpy(static_cast<void *>(&span.record_size), static_cast<const void *>(record), header_size);
+		return span;
+	}
+
+
+
+	void pop() PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+
+		size_type size;
+		std::memcpy(static_cast<void *>(&size), static_cast<const void *>(first_group->data() + start_offset), header_size);
+		const size_type footprint = record_footprint(size);
+		total_bytes -= footprint;
+
+		if (--total_size == 0)
+		{
+			start_offset = top_offset = back_offset = 0;
+		}
+		else if ((start_offset += footprint) == first_group->used && first_group != current_group)
+		{ // ie. was the last record in first_group
+			retire_first_group();
+			start_offset = 0;
+		}
+	}
+
+
+
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() const PLF_NOEXCEPT
+	{
+		return total_size == 0;
+	}
+
+
+
+	// Number of records:
+	size_type size() const PLF_NOEXCEPT
+	{
+		return total_size;
+	}
+
+
+
+	// Bytes used by records, including length prefixes and padding:
+	size_type bytes() const PLF_NOEXCEPT
+	{
+		return total_bytes;
+	}
+
+
+
+	// In bytes:
+	size_type capacity() const PLF_NOEXCEPT
+	{
+		return total_capacity;
+	}
+
+
+
+	size_type memory() const PLF_NOEXCEPT
+	{
+		return sizeof(*this) + groups_memory();
+	}
+
+
+
+	void reshape(const size_type min, const size_type max)
+	{
+		check_capacities_conformance(min, max, header_size * 2);
+		min_block_capacity = min;
+		max_block_capacity = max;
+	}
+
+
+
+	void clear() PLF_NOEXCEPT
+	{
+		destroy_all_data();
+	}
+
+
+
+	// Remove trailing groups (as may be created by reserve or pop)
+	using chain_type::trim;
+
+
+
+	// Reserve capacity in bytes:
+	using chain_type::reserve;
+
+
+
+	void swap(byte_queue &source) PLF_NOEXCEPT
+	{
+		swap_chain(source);
+		std::swap(start_offset, source.start_offset);
+		std::swap(top_offset, source.top_offset);
+		std::swap(back_offset, source.back_offset);
+		std::swap(total_bytes, source.total_bytes);
+	}
+}; // byte_queue
+
+
+} // plf namespace
+
+
+
+namespace std
+{
+
+inline void swap (plf::byte_queue &a, plf::byte_queue &b) PLF_NOEXCEPT
+{
+	a.swap(b);
+}
+
+}
+
+
+
+#ifdef PLF_BYTE_QUEUE_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_BYTE_QUEUE_H
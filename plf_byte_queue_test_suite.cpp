@@ -0,0 +1,225 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+#include <cstring> // memcpy
+
+#include "plf_byte_queue.h"
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	unsigned int looper = 0;
+
+	while (++looper != 50)
+	{
+		{
+			title1("Test basics");
+
+			byte_queue b_queue;
+
+			failpass("Empty test", b_queue.empty());
+
+			const char message[] = "hello";
+			b_queue.push(message, sizeof(message));
+
+			failpass("Size test", b_queue.size() == 1);
+			failpass("Front size test", b_queue.front().size() == sizeof(message));
+			failpass("Front contents test", memcmp(b_queue.front().data(), message, sizeof(message)) == 0);
+			failpass("Bytes test", b_queue.bytes() == sizeof(std::size_t) * 2);
+
+			b_queue.pop();
+
+			failpass("Pop test", b_queue.empty() && b_queue.bytes() == 0);
+		}
+
+		{
+			title2("Emplace and rollover tests");
+
+			byte_queue b_queue(64, 256);
+
+			for (unsigned int temp = 0; temp != 1000; ++temp)
+			{
+				const unsigned int size = (temp % 37) + 1;
+				unsigned char *payload = b_queue.emplace(size);
+
+				for (unsigned int counter = 0; counter != size; ++counter)
+				{
+					payload[counter] = static_cast<unsigned char>(temp + counter);
+				}
+			}
+
+			failpass("Size test", b_queue.size() == 1000);
+			failpass("Back size test", b_queue.back().size() == (999 % 37) + 1);
+
+			bool contents_correct = true;
+			unsigned int temp = 0;
+
+			while (!b_queue.empty())
+			{
+				const byte_span span = b_queue.front();
+
+				if (span.size() != (temp % 37) + 1)
+				{
+					contents_correct = false;
+				}
+
+				for (unsigned int counter = 0; counter != span.size(); ++counter)
+				{
+					if (span.data()[counter] != static_cast<unsigned char>(temp + counter))
+					{
+						contents_correct = false;
+					}
+				}
+
+				b_queue.pop();
+				++temp;
+			}
+
+			failpass("Contents test", contents_correct && temp == 1000);
+			failpass("Bytes test", b_queue.bytes() == 0);
+		}
+
+		{
+			title2("Oversized record test");
+
+			byte_queue b_queue(64, 128);
+
+			b_queue.emplace(10);
+			unsigned char *payload = b_queue.emplace(1000);
+			memset(payload, 7, 1000);
+			b_queue.emplace(10);
+
+			failpass("Oversized capacity test", b_queue.capacity() >= 1000);
+
+			b_queue.pop();
+
+			failpass("Oversized front test", b_queue.front().size() == 1000 && b_queue.front().data()[999] == 7);
+
+			b_queue.pop();
+
+			failpass("Post-oversized front test", b_queue.front().size() == 10 && b_queue.size() == 1);
+
+			byte_queue b_queue2(64, 128);
+
+			b_queue2.emplace(8);
+			b_queue2.pop();
+			b_queue2.emplace(200)[199] = 3;
+
+			failpass("Oversized first record test", b_queue2.size() == 1 && b_queue2.front().size() == 200 && b_queue2.front().data()[199] == 3);
+
+			b_queue2.pop();
+			b_queue2.emplace(8)[0] = 4;
+
+			failpass("Oversized first record pop test", b_queue2.front().size() == 8 && b_queue2.front().data()[0] == 4);
+		}
+
+		{
+			title2("Reuse, copy and swap tests");
+
+			byte_queue b_queue(64, 1024);
+
+			for (unsigned int counter = 0; counter != 100; ++counter)
+			{
+				for (unsigned int temp = 0; temp != 50; ++temp)
+				{
+					b_queue.push(&temp, sizeof(temp));
+				}
+
+				for (unsigned int temp = 0; temp != 45; ++temp)
+				{
+					b_queue.pop();
+				}
+			}
+
+			failpass("Cycling size test", b_queue.size() == 500);
+
+			unsigned int value;
+			memcpy(&value, b_queue.front().data(), sizeof(value));
+
+			failpass("Cycling front test", value == 0);
+
+			byte_queue b_queue2(b_queue);
+
+			failpass("Copy size test", b_queue2.size() == 500 && b_queue2.bytes() == b_queue.bytes());
+
+			memcpy(&value, b_queue2.back().data(), sizeof(value));
+
+			failpass("Copy back test", value == 49);
+
+			byte_queue b_queue3;
+			b_queue3.push("x", 1);
+			b_queue3.swap(b_queue2);
+
+			failpass("Swap test", b_queue3.size() == 500 && b_queue2.size() == 1);
+
+			b_queue2 = b_queue3;
+
+			failpass("Copy assignment test", b_queue2.size() == 500);
+
+			b_queue.clear();
+
+			failpass("Clear test", b_queue.empty() && b_queue.capacity() == 0);
+
+			b_queue.reserve(10000);
+
+			failpass("Reserve test", b_queue.capacity() >= 10000);
+
+			const std::size_t capacity = b_queue.capacity();
+
+			for (unsigned int temp = 0; temp != 500; ++temp)
+			{
+				b_queue.push(&temp, sizeof(temp));
+			}
+
+			failpass("Reserve reuse test", b_queue.capacity() == capacity);
+
+			b_queue.push("x", 1);
+			b_queue.trim();
+
+			failpass("Memory test", b_queue.memory() > b_queue.capacity());
+		}
+	}
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
@@ -0,0 +1,414 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_CHANNEL_H
+#define PLF_CHANNEL_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_CHANNEL_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <cassert> // assert
+#include <coroutine> // std::coroutine_handle
+#include <cstddef> // std::size_t
+#include <mutex> // std::mutex, std::unique_lock
+#include <optional> // std::optional
+#include <utility> // std::move
+
+#include "plf_queue.h"
+
+
+
+namespace plf
+{
+
+
+// plf::channel is a thread-safe FIFO channel for C++20 coroutines, storing it's elements in a plf::queue.
+// co_await pop() yields std::optional<element_type>, which is empty once the channel is closed and drained. co_await push(value) yields false if the channel was closed, and only suspends when the channel is bounded and full.
+// A suspended consumer is handed the pushed value directly and resumed by the pushing thread, without the value passing through the queue. Likewise, a consumer which makes room in a full bounded channel moves a suspended producer's value into the queue and resumes it.
+// Waiters are stored intrusively in the awaiting coroutine's frame, so suspending does not allocate.
+
+template <class element_type>
+class channel
+{
+public:
+	typedef element_type	value_type;
+	typedef std::size_t	size_type;
+
+private:
+	struct pop_awaiter;
+	struct push_awaiter;
+
+	mutable std::mutex			mutex;
+	plf::queue<element_type>	elements;
+	size_type						bound; // 0 == unbounded
+	bool								is_closed;
+	pop_awaiter						*first_consumer, *last_consumer;
+	push_awaiter					*first_producer, *last_producer;
+
+
+
+	template <class waiter_type>
+	static void append_waiter(waiter_type * const waiter, waiter_type * &first, waiter_type * &last) noexcept
+	{
+		waiter->next = nullptr;
+
+		if (last == nullptr)
+		{
+			first = waiter;
+		}
+		else
+		{
+			last->next = waiter;
+		}
+
+		last = waiter;
+	}
+
+
+
+	template <class waiter_type>
+	static waiter_type * remove_first_waiter(waiter_type * &first, waiter_type * &last) noexcept
+	{
+		waiter_type * const waiter = first;
+		first = waiter->next;
+
+		if (first == nullptr) last = nullptr;
+
+		return waiter;
+	}
+
+
+
+	struct pop_awaiter
+	{
+		channel									&source;
+		std::unique_lock<std::mutex>		lock;
+		std::optional<element_type>		result;
+		std::coroutine_handle<>				handle;
+		pop_awaiter								*next;
+
+		explicit pop_awaiter(channel &target) noexcept:
+			source(target),
+			lock(target.mutex, std::defer_lock),
+			next(nullptr)
+		{}
+
+		bool await_ready()
+		{
+			lock.lock();
+
+			if (!source.elements.empty())
+			{
+				result.emplace(std::move(source.elements.front()));
+				source.elements.pop();
+
+				if (source.first_producer != nullptr) // channel was full - move the first suspended producer's value into the freed space
+				{
+					source.elements.push(std::move(*source.first_producer->value)); // if this throws, the producer stays suspended with it's value
+					push_awaiter * const producer = remove_first_waiter(source.first_producer, source.last_producer);
+					producer->result = true;
+					lock.unlock();
+					producer->handle.resume();
+					return true;
+				}
+
+				lock.unlock();
+				return true;
+			}
+
+			if (source.is_closed)
+			{
+				lock.unlock();
+				return true;
+			}
+
+			return false; // lock is held until await_suspend has registered this waiter
+		}
+
+		void await_suspend(const std::coroutine_handle<> awaiting) noexcept
+		{
+			handle = awaiting;
+			append_waiter(this, source.first_consumer, source.last_consumer);
+			lock.release()->unlock(); // this awaiter may be resumed and destroyed by another thread as soon as the mutex is unlocked, so the lock object must not be touched afterwards
+		}
+
+		std::optional<element_type> await_resume()
+		{
+			return std::move(result);
+		}
+	};
+
+
+
+	struct push_awaiter
+	{
+		channel								&source;
+		std::unique_lock<std::mutex>	lock;
+		element_type						*value;
+		bool									result;
+		std::coroutine_handle<>			handle;
+		push_awaiter						*next;
+
+		push_awaiter(channel &target, element_type &element) noexcept:
+			source(target),
+			lock(target.mutex, std::defer_lock),
+			value(&element),
+			result(false),
+			next(nullptr)
+		{}
+
+		bool await_ready()
+		{
+			lock.lock();
+
+			if (source.is_closed)
+			{
+				lock.unlock();
+				return true;
+			}
+
+			result = true;
+
+			if (source.first_consumer != nullptr) // channel is empty and a consumer is waiting - hand the value to it directly
+			{
+				source.first_consumer->result.emplace(std::move(*value));
+				pop_awaiter * const consumer = remove_first_waiter(source.first_consumer, source.last_consumer);
+				lock.unlock();
+				consumer->handle.resume();
+				return true;
+			}
+
+			if (source.bound == 0 || source.elements.size() < source.bound)
+			{
+				source.elements.push(std::move(*value));
+				lock.unlock();
+				return true;
+			}
+
+			result = false;
+			return false; // lock is held until await_suspend has registered this waiter
+		}
+
+		void await_suspend(const std::coroutine_handle<> awaiting) noexcept
+		{
+			handle = awaiting;
+			append_waiter(this, source.first_producer, source.last_producer);
+			lock.release()->unlock();
+		}
+
+		bool await_resume() const noexcept
+		{
+			return result;
+		}
+	};
+
+
+
+	// Holds the pushed value in the awaiting coroutine's frame while the producer is suspended:
+	struct push_operation
+	{
+		element_type	element;
+		push_awaiter	awaiter;
+
+		push_operation(channel &target, element_type &&value):
+			element(std::move(value)),
+			awaiter(target, element)
+		{}
+
+		push_operation(const push_operation &) = delete;
+		push_operation & operator = (const push_operation &) = delete;
+
+		bool await_ready() { return awaiter.await_ready(); }
+		void await_suspend(const std::coroutine_handle<> awaiting) noexcept { awaiter.await_suspend(awaiting); }
+		bool await_resume() const noexcept { return awaiter.await_resume(); }
+	};
+
+
+
+public:
+
+	// bounded_capacity == 0 means unbounded, in which case push never suspends:
+	explicit channel(const size_type bounded_capacity = 0):
+		bound(bounded_capacity),
+		is_closed(false),
+		first_consumer(nullptr),
+		last_consumer(nullptr),
+		first_producer(nullptr),
+		last_producer(nullptr)
+	{}
+
+
+
+	channel(const channel &source) = delete;
+	channel & operator = (const channel &source) = delete;
+
+
+
+	// The channel must be closed and every suspended coroutine resumed before destruction, as waiters live in the coroutines' frames:
+	~channel()
+	{
+		assert(first_consumer == nullptr && first_producer == nullptr);
+	}
+
+
+
+	// co_await channel.pop() - suspends until an element is available or the channel is closed:
+	[[nodiscard]] pop_awaiter pop() noexcept
+	{
+		return pop_awaiter(*this);
+	}
+
+
+
+	// co_await channel.push(value) - suspends while a bounded channel is full. Yields false if the channel was closed, in which case the value is discarded:
+	[[nodiscard]] push_operation push(element_type value)
+	{
+		return push_operation(*this, std::move(value));
+	}
+
+
+
+	// Non-suspending versions, usable outside of coroutines. try_push returns false if the channel is closed or full:
+	bool try_push(element_type value)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		if (is_closed) return false;
+
+		if (first_consumer != nullptr)
+		{
+			first_consumer->result.emplace(std::move(value));
+			pop_awaiter * const consumer = remove_first_waiter(first_consumer, last_consumer);
+			lock.unlock();
+			consumer->handle.resume();
+			return true;
+		}
+
+		if (bound != 0 && elements.size() >= bound) return false;
+
+		elements.push(std::move(value));
+		return true;
+	}
+
+
+
+	std::optional<element_type> try_pop()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		if (elements.empty()) return std::nullopt;
+
+		std::optional<element_type> result(std::move(elements.front()));
+		elements.pop();
+
+		if (first_producer != nullptr)
+		{
+			elements.push(std::move(*first_producer->value)); // if this throws, the producer stays suspended with it's value
+			push_awaiter * const producer = remove_first_waiter(first_producer, last_producer);
+			producer->result = true;
+			lock.unlock();
+			producer->handle.resume();
+		}
+
+		return result;
+	}
+
+
+
+	// Suspended consumers resume with an empty optional, and suspended producers with false. Elements already in the channel can still be popped:
+	void close()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		if (is_closed) return;
+
+		is_closed = true;
+		pop_awaiter *consumer = first_consumer;
+		push_awaiter *producer = first_producer;
+		first_consumer = last_consumer = nullptr;
+		first_producer = last_producer = nullptr;
+		lock.unlock();
+
+		while (consumer != nullptr)
+		{
+			pop_awaiter * const next = consumer->next; // read before resuming, as resumption may destroy the awaiter
+			consumer->handle.resume();
+			consumer = next;
+		}
+
+		while (producer != nullptr)
+		{
+			push_awaiter * const next = producer->next;
+			producer->handle.resume();
+			producer = next;
+		}
+	}
+
+
+
+	bool closed() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return is_closed;
+	}
+
+
+
+	size_type size() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return elements.size();
+	}
+
+
+
+	bool empty() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return elements.empty();
+	}
+
+
+
+	size_type capacity_bound() const noexcept
+	{
+		return bound;
+	}
+};
+
+
+} // plf namespace
+
+
+#endif // __cpp_impl_coroutine
+
+
+#ifdef PLF_CHANNEL_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_CHANNEL_H
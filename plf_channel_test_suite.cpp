@@ -0,0 +1,286 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+
+#include "plf_channel.h"
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+	#include <atomic> // std::atomic
+	#include <coroutine> // std::suspend_never
+	#include <exception> // std::terminate
+	#include <thread> // std::thread, std::this_thread::yield
+	#include <vector> // std::vector
+#endif
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+	// Minimal eager, fire-and-forget coroutine type for driving the channel:
+	struct detached_task
+	{
+		struct promise_type
+		{
+			detached_task get_return_object() noexcept { return detached_task(); }
+			std::suspend_never initial_suspend() noexcept { return std::suspend_never(); }
+			std::suspend_never final_suspend() noexcept { return std::suspend_never(); }
+			void return_void() noexcept {}
+			void unhandled_exception() noexcept { std::terminate(); }
+		};
+	};
+
+
+
+	detached_task produce(plf::channel<int> &channel, const int first, const int last, int &rejected, std::atomic<int> *finished = nullptr)
+	{
+		for (int number = first; number != last; ++number)
+		{
+			if (!co_await channel.push(number)) ++rejected;
+		}
+
+		if (finished != nullptr) finished->fetch_add(1);
+	}
+
+
+
+	detached_task consume(plf::channel<int> &channel, std::vector<int> &received, bool &done)
+	{
+		while (true)
+		{
+			std::optional<int> value = co_await channel.pop();
+
+			if (!value) break;
+
+			received.push_back(*value);
+		}
+
+		done = true;
+	}
+#endif
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+		unsigned int looper = 0;
+
+		while (++looper != 50)
+		{
+			{
+				title1("Test basics");
+
+				channel<int> i_channel;
+
+				failpass("Empty test", i_channel.empty() && !i_channel.try_pop() && !i_channel.closed());
+
+				for (int temp = 0; temp != 1000; ++temp)
+				{
+					i_channel.try_push(temp);
+				}
+
+				failpass("Size test", i_channel.size() == 1000 && i_channel.capacity_bound() == 0);
+
+				bool order = true;
+
+				for (int temp = 0; temp != 1000; ++temp)
+				{
+					order = order && i_channel.try_pop() == temp;
+				}
+
+				failpass("try_pop order test", order && i_channel.empty());
+
+				channel<int> bounded(10);
+				int pushed = 0;
+
+				while (bounded.try_push(pushed)) ++pushed;
+
+				failpass("Bounded try_push test", pushed == 10 && bounded.size() == 10);
+			}
+
+
+			{
+				title2("Suspension tests");
+
+				channel<int> i_channel;
+				std::vector<int> received;
+				bool done = false;
+				int rejected = 0;
+
+				consume(i_channel, received, done);
+
+				failpass("Consumer suspend test", received.empty() && !done);
+
+				i_channel.try_push(5);
+
+				failpass("Direct handoff test", received.size() == 1 && received[0] == 5 && i_channel.empty());
+
+				produce(i_channel, 0, 1000, rejected);
+
+				failpass("Unbounded push test", received.size() == 1001 && received.back() == 999 && rejected == 0 && i_channel.empty());
+
+				i_channel.close();
+
+				failpass("Close resumes consumer test", done && i_channel.closed());
+
+				produce(i_channel, 0, 10, rejected);
+
+				failpass("Push after close test", rejected == 10 && i_channel.empty());
+			}
+
+
+			{
+				title2("Bounded channel tests");
+
+				channel<int> i_channel(1);
+				std::vector<int> received;
+				bool done = false;
+				int rejected = 0;
+
+				produce(i_channel, 0, 10000, rejected);
+
+				failpass("Producer suspend test", i_channel.size() == 1);
+
+				consume(i_channel, received, done);
+
+				bool order = received.size() == 10000;
+
+				for (int temp = 0; order && temp != 10000; ++temp)
+				{
+					order = received[temp] == temp;
+				}
+
+				failpass("Ping-pong order test", order && rejected == 0 && !done);
+
+				channel<int> full_channel(2);
+				produce(full_channel, 0, 5, rejected);
+
+				failpass("Full channel test", full_channel.size() == 2);
+
+				failpass("try_pop resumes producer test", full_channel.try_pop() == 0 && full_channel.size() == 2);
+
+				full_channel.close();
+
+				failpass("Close rejects suspended producer test", rejected == 2 && full_channel.size() == 2);
+				failpass("Drain after close test", full_channel.try_pop() == 1 && full_channel.try_pop() == 2 && full_channel.empty());
+
+				i_channel.close();
+
+				failpass("Consumer finish test", done);
+			}
+
+
+			{
+				title2("Fan-out tests");
+
+				channel<int> i_channel;
+				std::vector<int> received[4];
+				bool done[4] = {false, false, false, false};
+				int rejected = 0;
+
+				for (int consumer = 0; consumer != 4; ++consumer)
+				{
+					consume(i_channel, received[consumer], done[consumer]);
+				}
+
+				produce(i_channel, 0, 400, rejected);
+
+				bool fair = true;
+
+				for (int consumer = 0; consumer != 4; ++consumer)
+				{
+					fair = fair && received[consumer].size() == 100 && received[consumer][0] == consumer && !done[consumer];
+				}
+
+				failpass("Fan-out test", fair && rejected == 0);
+
+				i_channel.close();
+
+				failpass("Close all consumers test", done[0] && done[1] && done[2] && done[3]);
+			}
+
+
+			{
+				title2("Multithreaded tests");
+
+				channel<int> i_channel(16);
+				std::vector<int> received;
+				bool done = false;
+				int rejected[4] = {0, 0, 0, 0};
+				std::atomic<int> finished(0);
+
+				consume(i_channel, received, done);
+
+				std::vector<std::thread> producers;
+
+				for (int producer = 0; producer != 4; ++producer)
+				{
+					producers.emplace_back([&, producer] () { produce(i_channel, producer * 10000, (producer + 1) * 10000, rejected[producer], &finished); });
+				}
+
+				for (std::thread &producer : producers)
+				{
+					producer.join();
+				}
+
+				// Suspended producers are resumed on whichever thread makes room, so may outlive the thread that started them:
+				while (finished.load() != 4)
+				{
+					std::this_thread::yield();
+				}
+
+				i_channel.close();
+
+				long long total = 0;
+
+				for (int value : received)
+				{
+					total += value;
+				}
+
+				failpass("Multithreaded transfer test", done && received.size() == 40000 && total == 39999LL * 40000LL / 2 && rejected[0] + rejected[1] + rejected[2] + rejected[3] == 0);
+			}
+		}
+	#endif
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
@@ -0,0 +1,441 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_COALESCING_QUEUE_H
+#define PLF_COALESCING_QUEUE_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_COALESCING_QUEUE_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <functional> // std::hash, std::equal_to
+#include <utility> // std::forward, std::move, std::swap
+#include <vector> // hash index
+
+#include "plf_queue.h"
+
+
+
+namespace plf
+{
+
+
+// plf::coalescing_queue is a keyed FIFO queue which holds at most one pending element per key. Pushing a key which is already pending overwrites that element's value in place, so it keeps it's original position - ie. order is by first arrival, value is the latest. Once an element is popped, a later push of it's key is appended to the back as normal.
+// Key/value pairs are stored in a plf::queue, whose elements never move, so the index is an open-addressing hash table of pointers to them (linear probing, kept at most half full, with backward-shift deletion). Memory use is therefore bounded by the number of distinct pending keys rather than the number of pushes.
+
+template <class key_type, class element_type, class hash_type = std::hash<key_type>, class key_equal_type = std::equal_to<key_type>, plf::priority priority = plf::memory_use>
+class coalescing_queue
+{
+public:
+	typedef element_type		value_type;
+	typedef std::size_t		size_type;
+
+	struct entry_type
+	{
+		const key_type	key;
+		element_type	value;
+
+		template<typename key_input_type, typename value_input_type>
+		entry_type(key_input_type &&entry_key, value_input_type &&entry_value):
+			key(std::forward<key_input_type>(entry_key)),
+			value(std::forward<value_input_type>(entry_value))
+		{}
+	};
+
+private:
+	struct index_slot
+	{
+		entry_type		*entry; // NULL when the slot is empty
+		std::size_t		hash;
+	};
+
+	plf::queue<entry_type, priority>	entries;
+	std::vector<index_slot>				index; // size is always 0 or a power of two
+	hash_type								hasher;
+	key_equal_type							key_equal;
+	size_type								coalesce_count;
+
+
+
+	size_type index_mask() const PLF_NOEXCEPT
+	{
+		return index.size() - 1;
+	}
+
+
+
+	// Returns the slot holding the key, or the empty slot where it would be inserted:
+	size_type find_slot(const key_type &key, const std::size_t hash) const
+	{
+		size_type slot = hash & index_mask();
+
+		while (index[slot].entry != NULL && !(index[slot].hash == hash && key_equal(index[slot].entry->key, key)))
+		{
+			slot = (slot + 1) & index_mask();
+		}
+
+		return slot;
+	}
+
+
+
+	void insert_into_index(entry_type * const entry, const std::size_t hash) PLF_NOEXCEPT
+	{
+		size_type slot = hash & index_mask();
+
+		while (index[slot].entry != NULL)
+		{
+			slot = (slot + 1) & index_mask();
+		}
+
+		index[slot].entry = entry;
+		index[slot].hash = hash;
+	}
+
+
+
+	// Backward-shift deletion - moves later entries of the same probe run back into the gap, so lookups never need tombstones:
+	void erase_from_index(size_type slot) PLF_NOEXCEPT
+	{
+		for (size_type next = (slot + 1) & index_mask(); index[next].entry != NULL; next = (next + 1) & index_mask())
+		{
+			const size_type home = index[next].hash & index_mask();
+
+			if (((next - home) & index_mask()) >= ((next - slot) & index_mask())) // next's home slot is at or before the gap, cyclically
+			{
+				index[slot] = index[next];
+				slot = next;
+			}
+		}
+
+		index[slot].entry = NULL;
+	}
+
+
+
+	void rebuild_index(const size_type slot_count)
+	{
+		std::vector<index_slot> new_index(slot_count, index_slot());
+		index.swap(new_index);
+
+		for (typename std::vector<index_slot>::iterator current = new_index.begin(); current != new_index.end(); ++current)
+		{
+			if (current->entry != NULL) insert_into_index(current->entry, current->hash);
+		}
+	}
+
+
+
+	// Keep the index at most half full:
+	void grow_index_for(const size_type count)
+	{
+		if (count * 2 <= index.size()) return;
+
+		size_type slot_count = (index.size() == 0) ? 16 : index.size();
+
+		while (slot_count < count * 2)
+		{
+			slot_count *= 2;
+		}
+
+		rebuild_index(slot_count);
+	}
+
+
+
+	void index_all_entries()
+	{
+		index.assign(index.size(), index_slot());
+		grow_index_for(entries.size());
+
+		typename plf::queue<entry_type, priority>::iterator current = entries.begin();
+
+		for (size_type remaining = entries.size(); remaining != 0; --remaining, ++current)
+		{
+			insert_into_index(&*current, hasher(current->key));
+		}
+	}
+
+
+
+	template<typename key_input_type, typename value_input_type>
+	bool push_entry(key_input_type &&key, value_input_type &&value)
+	{
+		grow_index_for(entries.size() + 1);
+
+		const std::size_t hash = hasher(key);
+		const size_type slot = find_slot(key, hash);
+
+		if (index[slot].entry != NULL)
+		{
+			index[slot].entry->value = std::forward<value_input_type>(value);
+			++coalesce_count;
+			return false;
+		}
+
+		entries.emplace(std::forward<key_input_type>(key), std::forward<value_input_type>(value));
+		index[slot].entry = &entries.back();
+		index[slot].hash = hash;
+		return true;
+	}
+
+
+
+public:
+
+	coalescing_queue():
+		coalesce_count(0)
+	{}
+
+
+
+	coalescing_queue(const size_type min, const size_type max = plf::queue<entry_type, priority>::default_max_block_capacity()):
+		entries(min, max),
+		coalesce_count(0)
+	{}
+
+
+
+	coalescing_queue(const coalescing_queue &source):
+		entries(source.entries),
+		hasher(source.hasher),
+		key_equal(source.key_equal),
+		coalesce_count(source.coalesce_count)
+	{
+		index_all_entries();
+	}
+
+
+
+	coalescing_queue(coalescing_queue &&source) PLF_NOEXCEPT:
+		entries(std::move(source.entries)),
+		index(std::move(source.index)),
+		hasher(std::move(source.hasher)),
+		key_equal(std::move(source.key_equal)),
+		coalesce_count(source.coalesce_count)
+	{
+		source.index.clear();
+		source.coalesce_count = 0;
+	}
+
+
+
+	coalescing_queue & operator = (const coalescing_queue &source)
+	{
+		if (&source != this)
+		{
+			coalescing_queue temp(source);
+			swap(temp);
+		}
+
+		return *this;
+	}
+
+
+
+	coalescing_queue & operator = (coalescing_queue &&source) PLF_NOEXCEPT
+	{
+		assert(&source != this);
+		swap(source);
+		source.clear();
+		return *this;
+	}
+
+
+
+	// Returns true if the key was not already pending and the element was appended, false if the pending element's value was overwritten:
+	bool push(const key_type &key, const element_type &value)
+	{
+		return push_entry(key, value);
+	}
+
+
+
+	bool push(const key_type &key, element_type &&value)
+	{
+		return push_entry(key, std::move(value));
+	}
+
+
+
+	bool push(key_type &&key, element_type &&value)
+	{
+		return push_entry(std::move(key), std::move(value));
+	}
+
+
+
+	// The pending entry (key and latest value) which arrived first:
+	entry_type & front() // Exception may occur if queue is empty in release mode
+	{
+		return entries.front();
+	}
+
+
+
+	const entry_type & front() const
+	{
+		return entries.front();
+	}
+
+
+
+	void pop() // Exception may occur if queue is empty
+	{
+		assert(!entries.empty());
+		entry_type * const front_entry = &entries.front();
+		size_type slot = hasher(front_entry->key) & index_mask();
+
+		while (index[slot].entry != front_entry)
+		{
+			slot = (slot + 1) & index_mask();
+		}
+
+		erase_from_index(slot);
+		entries.pop();
+	}
+
+
+
+	// Returns the pending value for the key, or NULL:
+	element_type * find(const key_type &key)
+	{
+		if (entries.empty()) return NULL;
+
+		entry_type * const entry = index[find_slot(key, hasher(key))].entry;
+		return (entry == NULL) ? NULL : &entry->value;
+	}
+
+
+
+	const element_type * find(const key_type &key) const
+	{
+		return const_cast<coalescing_queue *>(this)->find(key);
+	}
+
+
+
+	bool contains(const key_type &key) const
+	{
+		return find(key) != NULL;
+	}
+
+
+
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() const PLF_NOEXCEPT
+	{
+		return entries.empty();
+	}
+
+
+
+	// Number of distinct pending keys:
+	size_type size() const PLF_NOEXCEPT
+	{
+		return entries.size();
+	}
+
+
+
+	// Number of pushes which overwrote a pending value rather than appending:
+	size_type coalesced() const PLF_NOEXCEPT
+	{
+		return coalesce_count;
+	}
+
+
+
+	size_type memory() const PLF_NOEXCEPT
+	{
+		return sizeof(*this) + (entries.memory() - sizeof(entries)) + (index.capacity() * sizeof(index_slot));
+	}
+
+
+
+	void reserve(const size_type reserve_amount)
+	{
+		entries.reserve(reserve_amount);
+		grow_index_for(reserve_amount);
+	}
+
+
+
+	void clear() PLF_NOEXCEPT
+	{
+		entries.clear();
+		index.clear();
+		coalesce_count = 0;
+	}
+
+
+
+	void trim() PLF_NOEXCEPT
+	{
+		entries.trim();
+	}
+
+
+
+	void swap(coalescing_queue &source) PLF_NOEXCEPT
+	{
+		entries.swap(source.entries);
+		index.swap(source.index);
+		std::swap(hasher, source.hasher);
+		std::swap(key_equal, source.key_equal);
+		std::swap(coalesce_count, source.coalesce_count);
+	}
+}; // coalescing_queue
+
+
+} // plf namespace
+
+
+
+namespace std
+{
+
+template <class key_type, class element_type, class hash_type, class key_equal_type, plf::priority priority>
+void swap (plf::coalescing_queue<key_type, element_type, hash_type, key_equal_type, priority> &a, plf::coalescing_queue<key_type, element_type, hash_type, key_equal_type, priority> &b) PLF_NOEXCEPT
+{
+	a.swap(b);
+}
+
+}
+
+
+#endif // PLF_VARIADICS_SUPPORT etc
+
+
+#ifdef PLF_COALESCING_QUEUE_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_COALESCING_QUEUE_H
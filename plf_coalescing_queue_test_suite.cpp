@@ -0,0 +1,206 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+#include <deque> // reference model
+#include <map> // reference model
+#include <string> // std::string keys
+#include <utility> // std::move
+
+#include "plf_coalescing_queue.h"
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+	struct colliding_hash // forces long probe runs, to exercise backward-shift deletion
+	{
+		std::size_t operator () (const unsigned int key) const
+		{
+			return key % 7;
+		}
+	};
+#endif
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+		unsigned int looper = 0;
+
+		while (++looper != 50)
+		{
+			{
+				title1("Test basics");
+
+				coalescing_queue<std::string, int> c_queue;
+
+				failpass("Empty test", c_queue.empty() && c_queue.find("AAPL") == NULL && !c_queue.contains("AAPL"));
+
+				failpass("Append test", c_queue.push("AAPL", 1) && c_queue.push("MSFT", 2) && c_queue.push("GOOG", 3));
+				failpass("Coalesce test", !c_queue.push("MSFT", 20) && !c_queue.push("AAPL", 10) && c_queue.size() == 3 && c_queue.coalesced() == 2);
+				failpass("Find test", *c_queue.find("MSFT") == 20 && c_queue.contains("GOOG") && !c_queue.contains("IBM"));
+				failpass("First arrival order test", c_queue.front().key == "AAPL" && c_queue.front().value == 10);
+
+				c_queue.pop();
+
+				failpass("Pop removes key test", !c_queue.contains("AAPL") && c_queue.front().key == "MSFT" && c_queue.front().value == 20);
+
+				failpass("Re-push after pop test", c_queue.push("AAPL", 100) && c_queue.size() == 3);
+
+				c_queue.pop();
+				c_queue.pop();
+
+				failpass("Re-pushed key is at back test", c_queue.front().key == "AAPL" && c_queue.front().value == 100);
+
+				c_queue.clear();
+
+				failpass("Clear test", c_queue.empty() && c_queue.coalesced() == 0 && !c_queue.contains("AAPL"));
+			}
+
+
+			{
+				title2("Reference comparison tests");
+
+				coalescing_queue<unsigned int, unsigned int, colliding_hash> c_queue(8, 64);
+				std::deque<unsigned int> reference_order;
+				std::map<unsigned int, unsigned int> reference_values;
+				unsigned int seed = looper;
+				bool matches = true;
+
+				for (unsigned int counter = 0; counter != 20000 && matches; ++counter)
+				{
+					seed = seed * 1103515245 + 12345;
+					const unsigned int key = (seed >> 16) % 300;
+
+					if (((seed >> 8) % 3) != 0 || reference_order.empty())
+					{
+						const bool appended = reference_values.find(key) == reference_values.end();
+
+						if (appended) reference_order.push_back(key);
+
+						reference_values[key] = counter;
+						matches = c_queue.push(key, counter) == appended;
+					}
+					else
+					{
+						matches = c_queue.front().key == reference_order.front() && c_queue.front().value == reference_values[reference_order.front()];
+						reference_values.erase(reference_order.front());
+						reference_order.pop_front();
+						c_queue.pop();
+					}
+
+					if (matches && (counter % 97) == 0)
+					{
+						for (unsigned int check = 0; check != 300 && matches; ++check)
+						{
+							const unsigned int *value = c_queue.find(check);
+							const std::map<unsigned int, unsigned int>::iterator reference = reference_values.find(check);
+							matches = (value == NULL) ? reference == reference_values.end() : (reference != reference_values.end() && *value == reference->second);
+						}
+					}
+
+					matches = matches && c_queue.size() == reference_order.size();
+				}
+
+				failpass("Randomised coalescing test", matches);
+
+				coalescing_queue<unsigned int, unsigned int, colliding_hash> c_queue2(c_queue);
+				bool copy_matches = c_queue2.size() == c_queue.size();
+
+				for (std::size_t position = 0; copy_matches && !c_queue2.empty(); ++position)
+				{
+					copy_matches = c_queue2.front().key == reference_order[position] && *c_queue.find(c_queue2.front().key) == c_queue2.front().value;
+					c_queue2.pop();
+				}
+
+				failpass("Copy constructor test", copy_matches && c_queue.size() == reference_order.size());
+
+				c_queue2 = std::move(c_queue);
+
+				failpass("Move assignment test", c_queue2.size() == reference_order.size() && c_queue.empty() && !c_queue.contains(0));
+
+				c_queue.push(5, 5);
+
+				failpass("Push to moved-from test", c_queue.size() == 1 && *c_queue.find(5) == 5);
+
+				swap(c_queue, c_queue2);
+
+				failpass("Swap test", c_queue2.size() == 1 && c_queue.size() == reference_order.size());
+			}
+
+
+			{
+				title2("Bounded memory tests");
+
+				coalescing_queue<unsigned int, std::string> c_queue;
+				c_queue.reserve(100);
+
+				for (unsigned int counter = 0; counter != 100000; ++counter)
+				{
+					c_queue.push(counter % 100, std::string(counter % 50, 'x'));
+				}
+
+				const std::size_t memory = c_queue.memory();
+
+				for (unsigned int counter = 0; counter != 100000; ++counter)
+				{
+					c_queue.push(counter % 100, std::string(counter % 50, 'y'));
+				}
+
+				failpass("Distinct key bound test", c_queue.size() == 100 && c_queue.coalesced() == 199900 && c_queue.memory() == memory);
+
+				unsigned int popped = 0;
+
+				while (!c_queue.empty())
+				{
+					popped += c_queue.front().key == popped && c_queue.front().value == std::string((99900 + popped) % 50, 'y');
+					c_queue.pop();
+				}
+
+				failpass("Latest value test", popped == 100);
+			}
+		}
+	#endif
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
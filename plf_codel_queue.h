@@ -0,0 +1,610 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_CODEL_QUEUE_H
+#define PLF_CODEL_QUEUE_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_CODEL_QUEUE_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+
+#include <cassert> // assert
+#include <chrono> // std::chrono::steady_clock, durations
+#include <cmath> // std::sqrt
+#include <cstddef> // std::size_t
+#include <memory> // std::allocator, std::allocator_traits
+#include <utility> // std::forward, std::move
+
+#include "plf_queue.h"
+
+
+
+namespace plf
+{
+
+
+// plf::timestamped_queue is a plf::queue which records the time each element was enqueued, so that it's sojourn time (time spent in the queue) can be measured at the front.
+// Timestamps are stored as runs of {time, count} in a second plf::queue, rather than per element. By default every push reads the clock, but with set_stamp_interval(n) the clock is only read once per n pushes, and the elements in between share the run's timestamp. Alternatively push(element, now) stamps with a time the caller has already read, eg. once per batch, and consecutive pushes with the same time share a run.
+// A shared timestamp is never later than the element's true enqueue time, so ages are only ever over-estimated, by at most the span of a run.
+
+template <class element_type, class clock_type = std::chrono::steady_clock, plf::priority priority = plf::memory_use, class allocator_type = std::allocator<element_type> >
+class timestamped_queue
+{
+public:
+	typedef element_type								value_type;
+	typedef std::size_t								size_type;
+	typedef typename clock_type::time_point		time_point;
+	typedef typename clock_type::duration		duration;
+
+private:
+	struct stamp_run
+	{
+		time_point	time;
+		size_type	count;
+
+		stamp_run(const time_point run_time):
+			time(run_time),
+			count(1)
+		{}
+	};
+
+	typedef typename std::allocator_traits<allocator_type>::template rebind_alloc<stamp_run> run_allocator_type;
+
+	plf::queue<element_type, priority, allocator_type>		elements;
+	plf::queue<stamp_run, plf::memory_use, run_allocator_type>	runs;
+	size_type									stamp_interval, unstamped_remaining; // unstamped_remaining == pushes left before the clock is read again
+
+
+
+	// Called once the element has been pushed. If the new run cannot be allocated, the element is counted in the previous run instead, whose earlier time only over-estimates it's age. If there is no previous run, the element is the only one in the queue, so it is popped again and the exception rethrown, leaving the queue unchanged:
+	void add_run(const time_point time)
+	{
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			try
+			{
+				runs.emplace(time);
+			}
+			catch (...)
+			{
+				if (runs.empty())
+				{
+					elements.pop();
+					throw;
+				}
+
+				++runs.back().count;
+				unstamped_remaining = 0; // read the clock again on the next push
+			}
+		#else
+			runs.emplace(time);
+		#endif
+	}
+
+
+
+	void stamp()
+	{
+		if (unstamped_remaining == 0 || runs.empty())
+		{
+			unstamped_remaining = stamp_interval - 1;
+			add_run(clock_type::now());
+		}
+		else
+		{
+			++runs.back().count;
+			--unstamped_remaining;
+		}
+	}
+
+
+
+	void stamp(const time_point now)
+	{
+		if (!runs.empty() && runs.back().time == now)
+		{
+			++runs.back().count;
+		}
+		else
+		{
+			add_run(now);
+		}
+
+		unstamped_remaining = 0; // don't extend a caller-supplied time to later clock-stamped pushes
+	}
+
+
+
+	void unstamp_front() PLF_NOEXCEPT
+	{
+		if (--runs.front().count == 0) runs.pop();
+	}
+
+
+
+public:
+
+	timestamped_queue():
+		stamp_interval(1),
+		unstamped_remaining(0)
+	{}
+
+
+
+	timestamped_queue(const size_type min, const size_type max = plf::queue<element_type, priority, allocator_type>::default_max_block_capacity()):
+		elements(min, max),
+		stamp_interval(1),
+		unstamped_remaining(0)
+	{}
+
+
+
+	void push(const element_type &element)
+	{
+		elements.push(element);
+		stamp();
+	}
+
+
+
+	void push(element_type &&element)
+	{
+		elements.push(std::move(element));
+		stamp();
+	}
+
+
+
+	void push(const element_type &element, const time_point now)
+	{
+		elements.push(element);
+		stamp(now);
+	}
+
+
+
+	void push(element_type &&element, const time_point now)
+	{
+		elements.push(std::move(element));
+		stamp(now);
+	}
+
+
+
+	template<typename... arguments>
+	void emplace(arguments &&... parameters)
+	{
+		elements.emplace(std::forward<arguments>(parameters)...);
+		stamp();
+	}
+
+
+
+	element_type & front() const // Exception may occur if queue is empty in release mode
+	{
+		return elements.front();
+	}
+
+
+
+	// Exception may occur if queue is empty in release mode:
+	time_point front_enqueue_time() const
+	{
+		return runs.front().time;
+	}
+
+
+
+	// Head-of-line age ie. the sojourn time so far of the front element. Zero if the queue is empty:
+	duration head_age(const time_point now = clock_type::now()) const
+	{
+		return (runs.empty()) ? duration::zero() : now - runs.front().time;
+	}
+
+
+
+	void pop() // Exception may occur if queue is empty
+	{
+		elements.pop();
+		unstamp_front();
+	}
+
+
+
+	bool try_pop(element_type &destination)
+	{
+		if (!elements.try_pop(destination)) return false;
+
+		unstamp_front();
+		return true;
+	}
+
+
+
+	// The number of pushes per clock read. 1 (the default) stamps every element individually:
+	void set_stamp_interval(const size_type pushes_per_clock_read) PLF_NOEXCEPT
+	{
+		assert(pushes_per_clock_read != 0);
+		stamp_interval = pushes_per_clock_read;
+		unstamped_remaining = 0;
+	}
+
+
+
+	size_type stamp_interval_size() const PLF_NOEXCEPT
+	{
+		return stamp_interval;
+	}
+
+
+
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() const PLF_NOEXCEPT
+	{
+		return elements.empty();
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return elements.size();
+	}
+
+
+
+	size_type memory() const PLF_NOEXCEPT
+	{
+		return sizeof(*this) + (elements.memory() - sizeof(elements)) + (runs.memory() - sizeof(runs));
+	}
+
+
+
+	void reserve(const size_type reserve_amount)
+	{
+		elements.reserve(reserve_amount);
+	}
+
+
+
+	void clear() PLF_NOEXCEPT
+	{
+		elements.clear();
+		runs.clear();
+		unstamped_remaining = 0;
+	}
+
+
+
+	void trim() PLF_NOEXCEPT
+	{
+		elements.trim();
+		runs.trim();
+	}
+
+
+
+	void swap(timestamped_queue &source) PLF_NOEXCEPT
+	{
+		elements.swap(source.elements);
+		runs.swap(source.runs);
+		std::swap(stamp_interval, source.stamp_interval);
+		std::swap(unstamped_remaining, source.unstamped_remaining);
+	}
+}; // timestamped_queue
+
+
+
+// plf::codel_queue is a timestamped_queue with CoDel (Controlled Delay) active queue management, following the control law in RFC 8289.
+// When the sojourn time of dequeued elements has stayed above 'target' for at least 'interval', the queue enters a dropping state and drops elements from the head, at intervals which shrink in proportion to the inverse square root of the number of drops, until the sojourn time falls back below target. Elements are never dropped when they are the last in the queue.
+// Dropped elements are passed to the function given to try_pop, so they can be counted, flagged or forwarded elsewhere rather than simply destroyed.
+// The clock is read once per try_pop, plus once per push (or per stamp interval) for the timestamps. clock_type can be any type with the std::chrono clock interface, eg. a manually-advanced clock for simulation.
+
+template <class element_type, class clock_type = std::chrono::steady_clock, plf::priority priority = plf::memory_use, class allocator_type = std::allocator<element_type> >
+class codel_queue
+{
+public:
+	typedef element_type																value_type;
+	typedef std::size_t																size_type;
+	typedef timestamped_queue<element_type, clock_type, priority, allocator_type>	queue_type;
+	typedef typename clock_type::time_point										time_point;
+	typedef typename clock_type::duration										duration;
+
+private:
+	struct discard_element
+	{
+		void operator () (element_type &) const PLF_NOEXCEPT
+		{}
+	};
+
+	queue_type		elements;
+	duration			target, interval;
+	time_point		first_above_time, drop_next; // time_point() means unset, as 0 in RFC 8289
+	size_type		drop_count, last_drop_count, total_dropped;
+	bool				is_dropping;
+
+
+
+	time_point control_law(const time_point time, const size_type count) const
+	{
+		return time + std::chrono::duration_cast<duration>(std::chrono::duration<double, typename duration::period>(static_cast<double>(interval.count()) / std::sqrt(static_cast<double>(count))));
+	}
+
+
+
+	// RFC 8289's dodequeue - pops the front element into destination, and determines whether it may be dropped:
+	bool dequeue_front(element_type &destination, const time_point now, bool &ok_to_drop)
+	{
+		ok_to_drop = false;
+
+		if (elements.empty())
+		{
+			first_above_time = time_point();
+			return false;
+		}
+
+		const duration sojourn_time = now - elements.front_enqueue_time();
+		elements.try_pop(destination);
+
+		if (sojourn_time < target || elements.empty()) // below target, or no backlog left to shed
+		{
+			first_above_time = time_point();
+		}
+		else if (first_above_time == time_point())
+		{
+			first_above_time = now + interval;
+		}
+		else if (now >= first_above_time)
+		{
+			ok_to_drop = true;
+		}
+
+		return true;
+	}
+
+
+
+public:
+
+	explicit codel_queue(const duration target_sojourn = std::chrono::milliseconds(5), const duration control_interval = std::chrono::milliseconds(100)):
+		target(target_sojourn),
+		interval(control_interval),
+		drop_count(0),
+		last_drop_count(0),
+		total_dropped(0),
+		is_dropping(false)
+	{
+		assert(interval > duration::zero());
+	}
+
+
+
+	void push(const element_type &element)
+	{
+		elements.push(element);
+	}
+
+
+
+	void push(element_type &&element)
+	{
+		elements.push(std::move(element));
+	}
+
+
+
+	void push(const element_type &element, const time_point now)
+	{
+		elements.push(element, now);
+	}
+
+
+
+	void push(element_type &&element, const time_point now)
+	{
+		elements.push(std::move(element), now);
+	}
+
+
+
+	template<typename... arguments>
+	void emplace(arguments &&... parameters)
+	{
+		elements.emplace(std::forward<arguments>(parameters)...);
+	}
+
+
+
+	// Pops the next element which is not dropped into destination, passing any dropped elements to on_drop. Returns false if the queue is (or becomes) empty:
+	template <class drop_function_type>
+	bool try_pop(element_type &destination, drop_function_type on_drop)
+	{
+		const time_point now = clock_type::now();
+		bool ok_to_drop;
+		bool has_element = dequeue_front(destination, now, ok_to_drop);
+
+		if (is_dropping)
+		{
+			if (!ok_to_drop)
+			{
+				is_dropping = false; // sojourn time is below target - leave the dropping state
+			}
+			else
+			{
+				while (now >= drop_next && is_dropping)
+				{
+					on_drop(destination);
+					++drop_count;
+					++total_dropped;
+					has_element = dequeue_front(destination, now, ok_to_drop);
+
+					if (!ok_to_drop)
+					{
+						is_dropping = false;
+					}
+					else
+					{
+						drop_next = control_law(drop_next, drop_count);
+					}
+				}
+			}
+		}
+		else if (ok_to_drop)
+		{
+			on_drop(destination);
+			++total_dropped;
+			has_element = dequeue_front(destination, now, ok_to_drop);
+			is_dropping = true;
+
+			// If min went above target close to when it last went below, assume the drop rate which controlled the queue last time is a good starting point:
+			const size_type delta = drop_count - last_drop_count;
+			drop_count = (delta > 1 && now - drop_next < interval * 16) ? delta : 1;
+			drop_next = control_law(now, drop_count);
+			last_drop_count = drop_count;
+		}
+
+		return has_element;
+	}
+
+
+
+	bool try_pop(element_type &destination)
+	{
+		return try_pop(destination, discard_element());
+	}
+
+
+
+	duration head_age(const time_point now = clock_type::now()) const
+	{
+		return elements.head_age(now);
+	}
+
+
+
+	void set_stamp_interval(const size_type pushes_per_clock_read) PLF_NOEXCEPT
+	{
+		elements.set_stamp_interval(pushes_per_clock_read);
+	}
+
+
+
+	duration target_sojourn() const PLF_NOEXCEPT
+	{
+		return target;
+	}
+
+
+
+	duration control_interval() const PLF_NOEXCEPT
+	{
+		return interval;
+	}
+
+
+
+	// True while in CoDel's dropping state:
+	bool dropping() const PLF_NOEXCEPT
+	{
+		return is_dropping;
+	}
+
+
+
+	// Total number of elements dropped since construction or clear():
+	size_type dropped() const PLF_NOEXCEPT
+	{
+		return total_dropped;
+	}
+
+
+
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() const PLF_NOEXCEPT
+	{
+		return elements.empty();
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return elements.size();
+	}
+
+
+
+	size_type memory() const PLF_NOEXCEPT
+	{
+		return sizeof(*this) + (elements.memory() - sizeof(elements));
+	}
+
+
+
+	void clear() PLF_NOEXCEPT
+	{
+		elements.clear();
+		first_above_time = drop_next = time_point();
+		drop_count = last_drop_count = total_dropped = 0;
+		is_dropping = false;
+	}
+
+
+
+	void trim() PLF_NOEXCEPT
+	{
+		elements.trim();
+	}
+}; // codel_queue
+
+
+} // plf namespace
+
+
+
+namespace std
+{
+
+template <class element_type, class clock_type, plf::priority priority, class allocator_type>
+void swap (plf::timestamped_queue<element_type, clock_type, priority, allocator_type> &a, plf::timestamped_queue<element_type, clock_type, priority, allocator_type> &b) PLF_NOEXCEPT
+{
+	a.swap(b);
+}
+
+}
+
+
+#endif // PLF_VARIADICS_SUPPORT etc
+
+
+#ifdef PLF_CODEL_QUEUE_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_CODEL_QUEUE_H
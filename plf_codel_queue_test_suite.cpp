@@ -0,0 +1,355 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+#include <string> // std::string elements
+
+#include "plf_codel_queue.h"
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+	#include <deque> // reference model
+	#include <memory> // std::allocator
+	#include <new> // std::bad_alloc
+#endif
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+	struct manual_clock // advanced explicitly by the tests, and counts reads
+	{
+		typedef std::chrono::microseconds			duration;
+		typedef duration::rep							rep;
+		typedef duration::period						period;
+		typedef std::chrono::time_point<manual_clock>	time_point;
+		static const bool is_steady = true;
+
+		static time_point current;
+		static unsigned int reads;
+
+		static time_point now()
+		{
+			++reads;
+			return current;
+		}
+
+		static void advance(const duration amount)
+		{
+			current += amount;
+		}
+	};
+
+	manual_clock::time_point manual_clock::current = manual_clock::time_point(std::chrono::seconds(1));
+	unsigned int manual_clock::reads = 0;
+
+
+	unsigned int allocations_remaining = 0;
+
+
+	template <class element_type>
+	struct failing_allocator : public std::allocator<element_type> // throws std::bad_alloc once allocations_remaining reaches zero
+	{
+		typedef element_type value_type;
+
+		template <class other_type> struct rebind { typedef failing_allocator<other_type> other; };
+
+		failing_allocator() {}
+
+		template <class other_type>
+		failing_allocator(const failing_allocator<other_type> &) {}
+
+		element_type * allocate(const std::size_t size, const void * = 0)
+		{
+			if (allocations_remaining == 0) throw std::bad_alloc();
+
+			--allocations_remaining;
+			return std::allocator<element_type>::allocate(size);
+		}
+	};
+
+
+	struct drop_counter
+	{
+		unsigned int *count;
+
+		drop_counter(unsigned int *target): count(target) {}
+
+		void operator () (const int &)
+		{
+			++*count;
+		}
+	};
+#endif
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+		typedef std::chrono::milliseconds ms;
+
+		unsigned int looper = 0;
+
+		while (++looper != 25)
+		{
+			{
+				title1("Timestamped queue tests");
+
+				timestamped_queue<std::string, manual_clock> t_queue;
+
+				failpass("Empty test", t_queue.empty() && t_queue.head_age() == manual_clock::duration::zero());
+
+				t_queue.push("a");
+				manual_clock::advance(ms(10));
+				t_queue.push(std::string("b"));
+				manual_clock::advance(ms(10));
+				t_queue.emplace(3, 'c');
+
+				failpass("Head age test", t_queue.size() == 3 && t_queue.head_age() == ms(20) && t_queue.front() == "a");
+
+				t_queue.pop();
+
+				failpass("Head age after pop test", t_queue.head_age() == ms(10) && t_queue.front_enqueue_time() == manual_clock::current - ms(10));
+
+				std::string value;
+
+				failpass("Try pop test", t_queue.try_pop(value) && value == "b" && t_queue.head_age() == manual_clock::duration::zero());
+
+				t_queue.pop();
+
+				failpass("Drained test", t_queue.empty() && !t_queue.try_pop(value));
+
+				t_queue.set_stamp_interval(100);
+				const unsigned int reads = manual_clock::reads;
+
+				for (unsigned int counter = 0; counter != 1000; ++counter)
+				{
+					t_queue.push(std::string(counter % 10, 'x'));
+					manual_clock::advance(ms(1));
+				}
+
+				failpass("Stamp interval test", manual_clock::reads - reads == 10 && t_queue.stamp_interval_size() == 100);
+
+				for (unsigned int counter = 0; counter != 150; ++counter)
+				{
+					t_queue.pop();
+				}
+
+				failpass("Run timestamp test", t_queue.front_enqueue_time() == manual_clock::current - ms(900));
+
+				t_queue.clear();
+				t_queue.set_stamp_interval(1);
+				const manual_clock::time_point batch_time = manual_clock::current - ms(50);
+				const unsigned int reads2 = manual_clock::reads;
+
+				for (unsigned int counter = 0; counter != 100; ++counter)
+				{
+					t_queue.push(std::string(1, 'y'), batch_time);
+				}
+
+				failpass("Caller-supplied time test", manual_clock::reads == reads2 && t_queue.head_age(manual_clock::current) == ms(50) && t_queue.size() == 100);
+
+				timestamped_queue<std::string, manual_clock> t_queue2;
+				t_queue2.push("z");
+				swap(t_queue, t_queue2);
+
+				failpass("Swap test", t_queue.size() == 1 && t_queue2.size() == 100 && t_queue2.front_enqueue_time() == batch_time);
+			}
+
+
+			{
+				title2("Allocation failure tests");
+
+				typedef timestamped_queue<int, manual_clock, plf::memory_use, failing_allocator<int> > failing_queue;
+
+				{
+					failing_queue t_queue(8, 8);
+					allocations_remaining = 2; // enough for the element's group (node and block) but not the run's
+					bool threw = false;
+
+					try
+					{
+						t_queue.push(1);
+					}
+					catch (std::bad_alloc &)
+					{
+						threw = true;
+					}
+
+					failpass("Failed first stamp leaves queue unchanged test", threw && t_queue.empty() && t_queue.head_age() == manual_clock::duration::zero());
+
+					allocations_remaining = 1000;
+					t_queue.push(2);
+
+					failpass("Push after failure test", t_queue.size() == 1 && t_queue.front() == 2 && t_queue.head_age() == manual_clock::duration::zero());
+				}
+
+				failing_queue t_queue(8, 8);
+				std::deque<int> reference;
+				bool matches = true;
+
+				for (int counter = 0; counter != 3000 && matches; ++counter)
+				{
+					if ((counter % 50) == 0)
+					{
+						allocations_remaining = 1000000;
+						t_queue.clear();
+						reference.clear();
+					}
+
+					allocations_remaining = ((counter % 4) == 0) ? static_cast<unsigned int>(counter % 3) : 1000000;
+					manual_clock::advance(ms(1)); // so that every push needs a new run
+
+					try
+					{
+						t_queue.push(counter);
+						reference.push_back(counter);
+					}
+					catch (std::bad_alloc &)
+					{}
+
+					allocations_remaining = 1000000;
+
+					if ((counter % 3) == 0 && !reference.empty())
+					{
+						matches = t_queue.front() == reference.front();
+						t_queue.pop();
+						reference.pop_front();
+					}
+
+					matches = matches && t_queue.size() == reference.size();
+				}
+
+				manual_clock::time_point previous_time;
+
+				while (matches && !reference.empty())
+				{
+					matches = t_queue.front() == reference.front() && t_queue.front_enqueue_time() >= previous_time && t_queue.head_age() >= manual_clock::duration::zero();
+					previous_time = t_queue.front_enqueue_time();
+					t_queue.pop();
+					reference.pop_front();
+				}
+
+				failpass("Every element stamped despite allocation failures test", matches && t_queue.empty() && t_queue.head_age() == manual_clock::duration::zero());
+			}
+
+
+			{
+				title2("CoDel tests");
+
+				codel_queue<int, manual_clock> c_queue(ms(5), ms(100));
+				unsigned int drops = 0;
+				int value = 0;
+
+				failpass("Parameters test", c_queue.target_sojourn() == ms(5) && c_queue.control_interval() == ms(100) && !c_queue.try_pop(value));
+
+				// Light load - each element is dequeued 1ms after being queued:
+				bool all_delivered = true;
+
+				for (int counter = 0; counter != 1000; ++counter)
+				{
+					c_queue.push(counter);
+					manual_clock::advance(ms(1));
+					all_delivered = all_delivered && c_queue.try_pop(value, drop_counter(&drops)) && value == counter;
+				}
+
+				failpass("No drops below target test", all_delivered && drops == 0 && !c_queue.dropping());
+
+				// Standing queue - 100 elements always waiting, so each sojourns for 100ms:
+				for (int counter = 0; counter != 100; ++counter)
+				{
+					c_queue.push(counter);
+				}
+
+				manual_clock::advance(ms(100));
+				unsigned int delivered = 0;
+
+				for (int counter = 0; counter != 5000; ++counter)
+				{
+					c_queue.push(counter);
+					manual_clock::advance(ms(1));
+					delivered += c_queue.try_pop(value, drop_counter(&drops));
+				}
+
+				failpass("Head drops under standing queue test", drops != 0 && c_queue.dropped() == drops);
+				failpass("Standing queue drained test", c_queue.size() < 100 && delivered + drops + c_queue.size() == 5100);
+
+				// Drop spacing shrinks as the drop count rises, so the queue is eventually brought back under target:
+				bool recovered = false;
+
+				for (int counter = 0; counter != 5000 && !recovered; ++counter)
+				{
+					c_queue.push(counter);
+					manual_clock::advance(ms(1));
+					c_queue.try_pop(value, drop_counter(&drops));
+					recovered = c_queue.head_age() < ms(5);
+				}
+
+				failpass("Sojourn brought under target test", recovered);
+
+				const unsigned int drops_before = drops;
+
+				for (int counter = 0; counter != 1000; ++counter)
+				{
+					c_queue.push(counter);
+					manual_clock::advance(ms(1));
+					c_queue.try_pop(value, drop_counter(&drops));
+				}
+
+				failpass("Steady state after recovery test", drops == drops_before && !c_queue.dropping());
+
+				while (c_queue.try_pop(value, drop_counter(&drops)))
+				{}
+
+				c_queue.push(1);
+				manual_clock::advance(ms(1000));
+
+				failpass("Last element never dropped test", c_queue.try_pop(value) && value == 1 && c_queue.dropped() == drops);
+
+				c_queue.clear();
+
+				failpass("Clear test", c_queue.empty() && c_queue.dropped() == 0 && !c_queue.dropping());
+			}
+		}
+	#endif
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
@@ -0,0 +1,424 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_COMPRESSED_QUEUE_H
+#define PLF_COMPRESSED_QUEUE_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_COMPRESSED_QUEUE_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <utility> // std::swap
+
+#ifdef PLF_TYPE_TRAITS_SUPPORT
+	#include <type_traits> // std::is_unsigned
+#endif
+
+#include "plf_queue_group_chain.h"
+
+
+
+namespace plf
+{
+
+
+// plf::compressed_queue is a FIFO queue of unsigned integers, intended for mostly-increasing streams such as sequence numbers and timestamps.
+// Each element is stored as the zigzag-encoded difference from the previous element, as a little-endian base-128 varint, so small steps in either direction take one or two bytes.
+// Elements are decoded one at a time as pop() reaches them. Group chain and group recycling behaviour matches plf::queue, though groups are always allocated with plain operator new and grow as per plf::memory_use (see plf::group_chain), with block capacities measured in bytes.
+
+template <class element_type>
+class compressed_queue : private plf::group_chain<plf::byte_group<1> >
+{
+public:
+	typedef element_type	value_type;
+	typedef std::size_t	size_type;
+
+private:
+	#ifdef PLF_TYPE_TRAITS_SUPPORT
+		static_assert(std::is_unsigned<element_type>::value, "plf::compressed_queue element_type must be an unsigned integer type");
+	#endif
+
+	typedef plf::byte_group<1>			group; // encodings are unaligned
+	typedef plf::group_chain<group>	chain_type;
+
+	static const size_type element_bits = sizeof(element_type) * 8;
+	static const size_type max_encoded_size = (element_bits + 6) / 7;
+
+	size_type		start_offset, top_offset; // offset just past the front element's encoding within first_group, and one-past the back element's encoding within current_group
+	size_type		total_bytes; // the number of encoded bytes in groups which hold elements
+	element_type	front_value, back_value; // front_value is the decoded front element, back_value is the base for the next push's delta
+
+
+
+	static unsigned char * encode(unsigned char *location, const element_type value, const element_type previous) PLF_NOEXCEPT
+	{
+		const element_type difference = static_cast<element_type>(value - previous);
+		element_type zigzag = static_cast<element_type>((difference << 1) ^ (static_cast<element_type>(0) - (difference >> (element_bits - 1)))); // small negative differences become small positive numbers
+
+		while (zigzag >= 0x80)
+		{
+			*location++ = static_cast<unsigned char>((zigzag & 0x7F) | 0x80);
+			zigzag = static_cast<element_type>(zigzag >> 7);
+		}
+
+		*location++ = static_cast<unsigned char>(zigzag);
+		return location;
+	}
+
+
+
+	static const unsigned char * decode(const unsigned char *location, element_type &value) PLF_NOEXCEPT // applies the next encoded difference to value
+	{
+		element_type zigzag = 0;
+		size_type shift = 0;
+
+		for (; *location & 0x80; shift += 7)
+		{
+			zigzag = static_cast<element_type>(zigzag | (static_cast<element_type>(*location++ & 0x7F) << shift));
+		}
+
+		zigzag = static_cast<element_type>(zigzag | (static_cast<element_type>(*location++) << shift));
+		value = static_cast<element_type>(value + static_cast<element_type>((zigzag >> 1) ^ (static_cast<element_type>(0) - (zigzag & 1))));
+		return location;
+	}
+
+
+
+	void progress_to_next_group() // used by push when the current group may not have room for another element
+	{
+		current_group->used = top_offset;
+		chain_type::progress_to_next_group(total_bytes, max_encoded_size);
+		top_offset = 0;
+	}
+
+
+
+	void copy_from_source(const compressed_queue &source)
+	{
+		if (source.total_size == 0) return;
+
+		push(source.front_value);
+
+		const group *current = source.first_group;
+		const unsigned char *location = source.first_group->data() + source.start_offset;
+		element_type value = source.front_value;
+
+		for (size_type remaining = source.total_size - 1; remaining != 0; --remaining)
+		{
+			if (current != source.current_group && location == const_cast<group *>(current)->data() + current->used)
+			{
+				current = current->next_group;
+				location = const_cast<group *>(current)->data();
+			}
+
+			location = decode(location, value);
+			push(value);
+		}
+	}
+
+
+
+	void destroy_all_data() PLF_NOEXCEPT
+	{
+		deallocate_all_groups();
+		blank();
+	}
+
+
+
+	void blank() PLF_NOEXCEPT
+	{
+		current_group = first_group = NULL;
+		start_offset = top_offset = total_size = total_bytes = total_capacity = 0;
+		front_value = back_value = 0;
+	}
+
+
+
+public:
+
+	static PLF_CONSTFUNC size_type default_min_block_capacity() PLF_NOEXCEPT
+	{
+		return 256;
+	}
+
+
+
+	static PLF_CONSTFUNC size_type default_max_block_capacity() PLF_NOEXCEPT
+	{
+		return 16384;
+	}
+
+
+
+	compressed_queue() PLF_NOEXCEPT:
+		chain_type(default_min_block_capacity(), default_max_block_capacity()),
+		start_offset(0),
+		top_offset(0),
+		total_bytes(0),
+		front_value(0),
+		back_value(0)
+	{}
+
+
+
+	// Constructor with limits, in bytes:
+	compressed_queue(const size_type min, const size_type max = default_max_block_capacity()):
+		chain_type(min, max),
+		start_offset(0),
+		top_offset(0),
+		total_bytes(0),
+		front_value(0),
+		back_value(0)
+	{
+		check_capacities_conformance(min, max, max_encoded_size * 2);
+	}
+
+
+
+	compressed_queue(const compressed_queue &source):
+		chain_type(source.min_block_capacity, source.max_block_capacity),
+		start_offset(0),
+		top_offset(0),
+		total_bytes(0),
+		front_value(0),
+		back_value(0)
+	{
+		copy_from_source(source);
+	}
+
+
+
+	#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+		compressed_queue(compressed_queue &&source) PLF_NOEXCEPT:
+			chain_type(source.min_block_capacity, source.max_block_capacity),
+			start_offset(0),
+			top_offset(0),
+			total_bytes(0),
+			front_value(0),
+			back_value(0)
+		{
+			swap(source);
+		}
+
+
+
+		compressed_queue & operator = (compressed_queue &&source) PLF_NOEXCEPT
+		{
+			assert(&source != this);
+
+			destroy_all_data();
+			swap(source);
+			return *this;
+		}
+	#endif
+
+
+
+	compressed_queue & operator = (const compressed_queue &source)
+	{
+		assert(&source != this);
+
+		compressed_queue temp(source);
+		swap(temp);
+		return *this;
+	}
+
+
+
+	~compressed_queue() PLF_NOEXCEPT
+	{
+		destroy_all_data();
+	}
+
+
+
+	void push(const element_type value)
+	{
+		if (current_group == NULL)
+		{
+			initialize(0);
+		}
+		else if (current_group->capacity - top_offset < max_encoded_size)
+		{
+			progress_to_next_group();
+		}
+
+		unsigned char * const location = current_group->data() + top_offset;
+		const size_type encoded_size = static_cast<size_type>(encode(location, value, back_value) - location);
+
+		top_offset += encoded_size;
+		total_bytes += encoded_size;
+		back_value = value;
+
+		if (total_size++ == 0) // the empty queue's first_group is always current_group
+		{
+			front_value = value;
+			start_offset = top_offset;
+		}
+	}
+
+
+
+	element_type front() const PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+		return front_value;
+	}
+
+
+
+	element_type back() const PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+		return back_value;
+	}
+
+
+
+	void pop() PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+
+		if (--total_size == 0)
+		{
+			start_offset = top_offset = total_bytes = 0; // back_value is retained as the base for the next push
+			return;
+		}
+
+		if (start_offset == first_group->used && first_group != current_group) // ie. the next element is in the next group
+		{
+			total_bytes -= first_group->used;
+			retire_first_group();
+			start_offset = 0;
+		}
+
+		const unsigned char * const location = first_group->data() + start_offset;
+		start_offset = static_cast<size_type>(decode(location, front_value) - first_group->data());
+	}
+
+
+
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() const PLF_NOEXCEPT
+	{
+		return total_size == 0;
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return total_size;
+	}
+
+
+
+	// In bytes:
+	size_type capacity() const PLF_NOEXCEPT
+	{
+		return total_capacity;
+	}
+
+
+
+	size_type memory() const PLF_NOEXCEPT
+	{
+		return sizeof(*this) + groups_memory();
+	}
+
+
+
+	// Uncompressed size of the elements divided by memory(). Values above 1 mean the queue uses less memory than the elements would uncompressed:
+	double compression_ratio() const PLF_NOEXCEPT
+	{
+		return static_cast<double>(total_size * sizeof(element_type)) / static_cast<double>(memory());
+	}
+
+
+
+	void reshape(const size_type min, const size_type max)
+	{
+		check_capacities_conformance(min, max, max_encoded_size * 2);
+		min_block_capacity = min;
+		max_block_capacity = max;
+	}
+
+
+
+	void clear() PLF_NOEXCEPT
+	{
+		destroy_all_data();
+	}
+
+
+
+	// Remove trailing groups (as may be created by reserve or pop)
+	using chain_type::trim;
+
+
+
+	// Reserve capacity in bytes:
+	using chain_type::reserve;
+
+
+
+	void swap(compressed_queue &source) PLF_NOEXCEPT
+	{
+		swap_chain(source);
+		std::swap(start_offset, source.start_offset);
+		std::swap(top_offset, source.top_offset);
+		std::swap(total_bytes, source.total_bytes);
+		std::swap(front_value, source.front_value);
+		std::swap(back_value, source.back_value);
+	}
+}; // compressed_queue
+
+
+} // plf namespace
+
+
+
+namespace std
+{
+
+template <class element_type>
+void swap (plf::compressed_queue<element_type> &a, plf::compressed_queue<element_type> &b) PLF_NOEXCEPT
+{
+	a.swap(b);
+}
+
+}
+
+
+
+#ifdef PLF_COMPRESSED_QUEUE_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_COMPRESSED_QUEUE_H
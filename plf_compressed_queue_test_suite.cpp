@@ -0,0 +1,204 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+#include <limits> // numeric_limits
+
+#include "plf_compressed_queue.h"
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	unsigned int looper = 0;
+
+	while (++looper != 50)
+	{
+		{
+			title1("Test basics");
+
+			compressed_queue<std::size_t> c_queue;
+
+			failpass("Empty test", c_queue.empty());
+
+			std::size_t value = 1000000;
+
+			for (unsigned int temp = 0; temp != 100000; ++temp)
+			{
+				value += (temp % 5 == 0) ? 3 : 1;
+				c_queue.push(value);
+			}
+
+			failpass("Size test", c_queue.size() == 100000);
+			failpass("Front test", c_queue.front() == 1000003);
+			failpass("Back test", c_queue.back() == value);
+			failpass("Compression test", c_queue.memory() < 100000 * 2 && c_queue.compression_ratio() > 3);
+
+			bool contents_correct = true;
+			value = 1000000;
+
+			for (unsigned int temp = 0; temp != 100000; ++temp)
+			{
+				value += (temp % 5 == 0) ? 3 : 1;
+
+				if (c_queue.front() != value)
+				{
+					contents_correct = false;
+				}
+
+				c_queue.pop();
+			}
+
+			failpass("Pop contents test", contents_correct && c_queue.empty());
+		}
+
+		{
+			title2("Decreasing and large difference tests");
+
+			compressed_queue<std::size_t> c_queue(32, 256);
+			const std::size_t maximum = std::numeric_limits<std::size_t>::max();
+			const std::size_t values[] = {5, 3, 0, maximum, 0, maximum / 2, 7, maximum - 1, 2};
+
+			for (unsigned int counter = 0; counter != 100; ++counter)
+			{
+				for (unsigned int temp = 0; temp != 9; ++temp)
+				{
+					c_queue.push(values[temp]);
+				}
+			}
+
+			bool contents_correct = true;
+
+			for (unsigned int counter = 0; counter != 50; ++counter)
+			{
+				for (unsigned int temp = 0; temp != 9; ++temp)
+				{
+					if (c_queue.front() != values[temp])
+					{
+						contents_correct = false;
+					}
+
+					c_queue.pop();
+				}
+			}
+
+			failpass("Round trip test", contents_correct && c_queue.size() == 450);
+
+			compressed_queue<std::size_t> c_queue2(c_queue);
+
+			failpass("Copy test", c_queue2.size() == 450 && c_queue2.front() == 5 && c_queue2.back() == 2);
+
+			for (unsigned int temp = 0; temp != 449; ++temp)
+			{
+				c_queue2.pop();
+			}
+
+			failpass("Copy contents test", c_queue2.front() == 2);
+
+			compressed_queue<unsigned char> small_queue(8, 16);
+
+			for (unsigned int temp = 0; temp != 1000; ++temp)
+			{
+				small_queue.push(static_cast<unsigned char>(temp * 37));
+			}
+
+			contents_correct = true;
+
+			for (unsigned int temp = 0; temp != 1000; ++temp)
+			{
+				if (small_queue.front() != static_cast<unsigned char>(temp * 37))
+				{
+					contents_correct = false;
+				}
+
+				small_queue.pop();
+			}
+
+			failpass("Small type test", contents_correct);
+		}
+
+		{
+			title2("Reuse and swap tests");
+
+			compressed_queue<std::size_t> c_queue(64, 512);
+			std::size_t pushed = 0, popped = 0;
+			bool contents_correct = true;
+
+			for (unsigned int counter = 0; counter != 100; ++counter)
+			{
+				for (unsigned int temp = 0; temp != 300; ++temp)
+				{
+					c_queue.push(pushed++ * 1000);
+				}
+
+				for (unsigned int temp = 0; temp != 290; ++temp)
+				{
+					if (c_queue.front() != popped++ * 1000)
+					{
+						contents_correct = false;
+					}
+
+					c_queue.pop();
+				}
+			}
+
+			failpass("Cycling test", contents_correct && c_queue.size() == 1000);
+
+			compressed_queue<std::size_t> c_queue2;
+			c_queue2.push(1);
+			c_queue2.swap(c_queue);
+
+			failpass("Swap test", c_queue.size() == 1 && c_queue2.size() == 1000 && c_queue2.front() == popped * 1000);
+
+			c_queue2.clear();
+			c_queue2.reserve(10000);
+
+			failpass("Reserve test", c_queue2.capacity() >= 10000 && c_queue2.empty());
+
+			c_queue2.push(12);
+
+			failpass("Post-clear push test", c_queue2.front() == 12 && c_queue2.back() == 12);
+		}
+	}
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
@@ -0,0 +1,430 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_LANE_QUEUE_H
+#define PLF_LANE_QUEUE_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_LANE_QUEUE_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#define PLF_INCLUDE_BIT_TOOLS
+#include "plf_tools.h"
+
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <memory> // std::allocator
+
+#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+	#include <utility> // std::move
+#endif
+
+#include "plf_queue.h"
+
+
+
+namespace plf
+{
+
+
+// plf::lane_queue is a strict-priority queue made up of 'levels' FIFO lanes, each a plf::queue. Level 0 is the highest priority.
+// front() and pop() always act on the oldest element of the highest-priority non-empty lane. An occupancy bitmap with one bit per lane means both are found with a single plf::countr_zero, so push and pop are O(1) regardless of the number of elements or levels.
+// Each lane allocates it's own groups, so the block capacity limits supplied to the constructor apply per-lane.
+// levels can be at most the bit-width of the bitmap: 64 in C++11 and above, the bit-width of std::size_t in C++03 (ie. 32 on 32-bit platforms), which is also the default there.
+
+#ifdef PLF_CPP11_SUPPORT
+	template <class element_type, unsigned int levels = 64, plf::priority priority = plf::memory_use, class allocator_type = std::allocator<element_type> >
+#else
+	template <class element_type, unsigned int levels = sizeof(std::size_t) * 8, plf::priority priority = plf::memory_use, class allocator_type = std::allocator<element_type> >
+#endif
+class lane_queue
+{
+public:
+	typedef plf::queue<element_type, priority, allocator_type>	lane_type;
+	typedef element_type													value_type;
+	typedef typename lane_type::size_type							size_type;
+	typedef typename lane_type::reference							reference;
+	typedef typename lane_type::const_reference					const_reference;
+
+private:
+	#ifdef PLF_CPP11_SUPPORT
+		typedef unsigned long long bitmap_type;
+		static_assert(levels != 0 && levels <= sizeof(bitmap_type) * 8, "plf::lane_queue levels must be between 1 and 64");
+	#else
+		typedef std::size_t bitmap_type; // levels is limited to the bit-width of std::size_t in C++03
+		typedef char levels_must_be_between_1_and_bitmap_width[(levels != 0 && levels <= sizeof(bitmap_type) * 8) ? 1 : -1]; // C++03 substitute for the static_assert above - array size is negative if levels is out of range
+	#endif
+
+	lane_type		lanes[levels];
+	bitmap_type		occupied; // bit n is set when lanes[n] is non-empty
+	size_type		total_size;
+
+
+
+	static PLF_CONSTFUNC bitmap_type level_bit(const unsigned int level) PLF_NOEXCEPT
+	{
+		return static_cast<bitmap_type>(1) << level;
+	}
+
+
+
+	unsigned int highest_occupied_level() const PLF_NOEXCEPT
+	{
+		assert(occupied != 0);
+		return static_cast<unsigned int>(plf::countr_zero(occupied));
+	}
+
+
+
+public:
+
+	lane_queue() PLF_NOEXCEPT:
+		occupied(0),
+		total_size(0)
+	{}
+
+
+
+	// Constructor with per-lane group capacity limits:
+	lane_queue(const size_type min, const size_type max = lane_type::default_max_block_capacity()):
+		occupied(0),
+		total_size(0)
+	{
+		reshape(min, max);
+	}
+
+
+
+	lane_queue(const lane_queue &source):
+		occupied(source.occupied),
+		total_size(source.total_size)
+	{
+		for (unsigned int level = 0; level != levels; ++level)
+		{
+			lanes[level] = source.lanes[level];
+		}
+	}
+
+
+
+	#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+		lane_queue(lane_queue &&source) PLF_NOEXCEPT:
+			occupied(source.occupied),
+			total_size(source.total_size)
+		{
+			for (unsigned int level = 0; level != levels; ++level)
+			{
+				lanes[level] = std::move(source.lanes[level]);
+			}
+
+			source.occupied = 0;
+			source.total_size = 0;
+		}
+	#endif
+
+
+
+	void push(const unsigned int level, const element_type &element)
+	{
+		assert(level < levels);
+		lanes[level].push(element);
+		occupied |= level_bit(level);
+		++total_size;
+	}
+
+
+
+	#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+		void push(const unsigned int level, element_type &&element)
+		{
+			assert(level < levels);
+			lanes[level].push(std::move(element));
+			occupied |= level_bit(level);
+			++total_size;
+		}
+	#endif
+
+
+
+	#ifdef PLF_VARIADICS_SUPPORT
+		template<typename... arguments>
+		void emplace(const unsigned int level, arguments &&... parameters)
+		{
+			assert(level < levels);
+			lanes[level].emplace(std::forward<arguments>(parameters)...);
+			occupied |= level_bit(level);
+			++total_size;
+		}
+	#endif
+
+
+
+	// The oldest element in the highest-priority non-empty lane:
+	reference front() const // Exception may occur if queue is empty in release mode
+	{
+		return lanes[highest_occupied_level()].front();
+	}
+
+
+
+	// The level of the element front() returns:
+	unsigned int front_level() const // Exception may occur if queue is empty in release mode
+	{
+		return highest_occupied_level();
+	}
+
+
+
+	void pop() // Exception may occur if queue is empty
+	{
+		const unsigned int level = highest_occupied_level();
+		lanes[level].pop();
+
+		if (lanes[level].empty()) occupied &= ~level_bit(level);
+
+		--total_size;
+	}
+
+
+
+	// Pop the oldest element of a specific lane, bypassing priority order:
+	void pop(const unsigned int level) // Exception may occur if lane is empty
+	{
+		assert(level < levels && (occupied & level_bit(level)) != 0);
+		lanes[level].pop();
+
+		if (lanes[level].empty()) occupied &= ~level_bit(level);
+
+		--total_size;
+	}
+
+
+
+	const lane_type & lane(const unsigned int level) const PLF_NOEXCEPT
+	{
+		assert(level < levels);
+		return lanes[level];
+	}
+
+
+
+	lane_queue & operator = (const lane_queue &source)
+	{
+		if (&source != this)
+		{
+			for (unsigned int level = 0; level != levels; ++level)
+			{
+				lanes[level] = source.lanes[level];
+			}
+
+			occupied = source.occupied;
+			total_size = source.total_size;
+		}
+
+		return *this;
+	}
+
+
+
+	#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+		lane_queue & operator = (lane_queue &&source) PLF_NOEXCEPT_MOVE_ASSIGN(allocator_type)
+		{
+			assert(&source != this);
+
+			for (unsigned int level = 0; level != levels; ++level)
+			{
+				lanes[level] = std::move(source.lanes[level]);
+			}
+
+			occupied = source.occupied;
+			total_size = source.total_size;
+			source.occupied = 0;
+			source.total_size = 0;
+			return *this;
+		}
+	#endif
+
+
+
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() const PLF_NOEXCEPT
+	{
+		return total_size == 0;
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return total_size;
+	}
+
+
+
+	static PLF_CONSTFUNC unsigned int level_count() PLF_NOEXCEPT
+	{
+		return levels;
+	}
+
+
+
+	size_type capacity() const PLF_NOEXCEPT
+	{
+		size_type total_capacity = 0;
+
+		for (unsigned int level = 0; level != levels; ++level)
+		{
+			total_capacity += lanes[level].capacity();
+		}
+
+		return total_capacity;
+	}
+
+
+
+	size_type memory() const PLF_NOEXCEPT
+	{
+		size_type memory_use = sizeof(*this) - sizeof(lanes);
+
+		for (unsigned int level = 0; level != levels; ++level)
+		{
+			memory_use += lanes[level].memory();
+		}
+
+		return memory_use;
+	}
+
+
+
+	void reshape(const size_type min, const size_type max)
+	{
+		for (unsigned int level = 0; level != levels; ++level)
+		{
+			lanes[level].reshape(min, max);
+		}
+	}
+
+
+
+	void reserve(const unsigned int level, const size_type reserve_amount)
+	{
+		assert(level < levels);
+		lanes[level].reserve(reserve_amount);
+	}
+
+
+
+	void clear() PLF_NOEXCEPT
+	{
+		for (unsigned int level = 0; level != levels; ++level)
+		{
+			lanes[level].clear();
+		}
+
+		occupied = 0;
+		total_size = 0;
+	}
+
+
+
+	void trim() PLF_NOEXCEPT
+	{
+		for (unsigned int level = 0; level != levels; ++level)
+		{
+			lanes[level].trim();
+		}
+	}
+
+
+
+	void shrink_to_fit()
+	{
+		for (unsigned int level = 0; level != levels; ++level)
+		{
+			lanes[level].shrink_to_fit();
+		}
+	}
+
+
+
+	friend bool operator == (const lane_queue &lh, const lane_queue &rh) PLF_NOEXCEPT
+	{
+		if (lh.occupied != rh.occupied || lh.total_size != rh.total_size) return false;
+
+		for (unsigned int level = 0; level != levels; ++level)
+		{
+			if (lh.lanes[level] != rh.lanes[level]) return false;
+		}
+
+		return true;
+	}
+
+
+
+	friend bool operator != (const lane_queue &lh, const lane_queue &rh) PLF_NOEXCEPT
+	{
+		return !(lh == rh);
+	}
+
+
+
+	void swap(lane_queue &source) PLF_NOEXCEPT_SWAP(allocator_type)
+	{
+		for (unsigned int level = 0; level != levels; ++level)
+		{
+			lanes[level].swap(source.lanes[level]);
+		}
+
+		const bitmap_type swap_occupied = occupied;
+		const size_type swap_size = total_size;
+		occupied = source.occupied;
+		total_size = source.total_size;
+		source.occupied = swap_occupied;
+		source.total_size = swap_size;
+	}
+};
+
+
+} // plf namespace
+
+
+
+namespace std
+{
+
+template <class element_type, unsigned int levels, plf::priority priority, class allocator_type>
+void swap (plf::lane_queue<element_type, levels, priority, allocator_type> &a, plf::lane_queue<element_type, levels, priority, allocator_type> &b) PLF_NOEXCEPT_SWAP(allocator_type)
+{
+	a.swap(b);
+}
+
+}
+
+
+
+#ifdef PLF_LANE_QUEUE_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_LANE_QUEUE_H
@@ -0,0 +1,221 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+#include <deque> // reference model
+#include <utility> // std::move
+
+#include "plf_lane_queue.h"
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	unsigned int looper = 0;
+
+	while (++looper != 50)
+	{
+		{
+			title1("Test basics");
+
+			lane_queue<int> l_queue;
+
+			#ifdef PLF_CPP11_SUPPORT
+				const unsigned int default_levels = 64;
+			#else
+				const unsigned int default_levels = sizeof(std::size_t) * 8; // bitmap is a std::size_t in C++03
+			#endif
+
+			const unsigned int last = default_levels - 1, middle = last - (last / 2);
+
+			failpass("Empty test", l_queue.empty() && l_queue.size() == 0 && l_queue.level_count() == default_levels);
+
+			for (int temp = 0; temp != 300; ++temp)
+			{
+				l_queue.push(last - (static_cast<unsigned int>(temp % 3) * (last / 2)), temp); // levels 63, 32, 1 with 64 levels
+			}
+
+			failpass("Size test", l_queue.size() == 300 && l_queue.lane(1).size() == 100 && l_queue.lane(middle).size() == 100 && l_queue.lane(last).size() == 100);
+			failpass("Front level test", l_queue.front_level() == 1 && l_queue.front() == 2);
+
+			bool order = true;
+
+			for (int temp = 0; temp != 300; ++temp)
+			{
+				const int expected = (temp < 100) ? (temp * 3) + 2 : (temp < 200) ? ((temp - 100) * 3) + 1 : (temp - 200) * 3;
+				order = order && l_queue.front() == expected;
+				l_queue.pop();
+			}
+
+			failpass("Priority then FIFO order test", order && l_queue.empty());
+
+			l_queue.push(0, 5);
+			l_queue.push(last, 6);
+
+			failpass("Highest and lowest level test", l_queue.front() == 5 && l_queue.front_level() == 0);
+
+			l_queue.pop(last);
+
+			failpass("Pop specific level test", l_queue.size() == 1 && l_queue.lane(last).empty() && l_queue.front() == 5);
+
+			l_queue.pop();
+
+			failpass("Empty after pop test", l_queue.empty());
+
+			l_queue.push(middle + 8, 7);
+
+			failpass("Bitmap cleared test", l_queue.front_level() == middle + 8 && l_queue.front() == 7);
+		}
+
+
+		{
+			title2("Reference comparison tests");
+
+			lane_queue<unsigned int, 20> l_queue;
+			std::deque<unsigned int> reference[20];
+			unsigned int reference_size = 0, seed = looper;
+			bool matches = true;
+
+			for (unsigned int counter = 0; counter != 50000; ++counter)
+			{
+				seed = seed * 1103515245 + 12345;
+
+				if (((seed >> 16) % 5) < 3 || reference_size == 0)
+				{
+					const unsigned int level = (seed >> 8) % 20;
+					l_queue.push(level, counter);
+					reference[level].push_back(counter);
+					++reference_size;
+				}
+				else
+				{
+					unsigned int level = 0;
+
+					while (reference[level].empty()) ++level;
+
+					matches = matches && l_queue.front_level() == level && l_queue.front() == reference[level].front();
+					l_queue.pop();
+					reference[level].pop_front();
+					--reference_size;
+				}
+
+				matches = matches && l_queue.size() == reference_size;
+			}
+
+			failpass("Randomised push/pop test", matches);
+
+			lane_queue<unsigned int, 20> l_queue2(l_queue);
+
+			failpass("Copy constructor test", l_queue2 == l_queue && l_queue2.size() == reference_size);
+
+			l_queue2.pop();
+
+			failpass("Inequality test", l_queue2 != l_queue);
+
+			lane_queue<unsigned int, 20> l_queue3;
+			l_queue3 = l_queue;
+
+			failpass("Copy assignment test", l_queue3 == l_queue);
+
+			l_queue3.swap(l_queue2);
+
+			failpass("Swap test", l_queue2 == l_queue && l_queue3.size() == reference_size - 1);
+
+			#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+				lane_queue<unsigned int, 20> l_queue4(std::move(l_queue3));
+
+				failpass("Move constructor test", l_queue4.size() == reference_size - 1 && l_queue3.empty());
+
+				l_queue3 = std::move(l_queue4);
+
+				failpass("Move assignment test", l_queue3.size() == reference_size - 1 && l_queue4.empty());
+
+				l_queue4.push(3, 1);
+
+				failpass("Push to moved-from test", l_queue4.size() == 1 && l_queue4.front() == 1);
+			#endif
+
+			l_queue.clear();
+
+			failpass("Clear test", l_queue.empty() && l_queue.capacity() == 0);
+
+			l_queue.push(19, 2);
+
+			failpass("Push after clear test", l_queue.front_level() == 19 && l_queue.front() == 2);
+		}
+
+
+		{
+			title2("Capacity tests");
+
+			lane_queue<int, 8> l_queue(16, 64);
+
+			l_queue.reserve(5, 1000);
+
+			failpass("Reserve test", l_queue.lane(5).capacity() >= 1000 && l_queue.capacity() == l_queue.lane(5).capacity() && l_queue.empty());
+
+			for (int temp = 0; temp != 1000; ++temp)
+			{
+				l_queue.push(static_cast<unsigned int>(temp % 8), temp);
+			}
+
+			failpass("Memory test", l_queue.memory() >= l_queue.capacity() * sizeof(int));
+
+			while (!l_queue.empty()) l_queue.pop();
+
+			l_queue.trim();
+			l_queue.shrink_to_fit();
+
+			failpass("Trim test", l_queue.capacity() <= 8 * 64);
+
+			#ifdef PLF_VARIADICS_SUPPORT
+				lane_queue<std::pair<int, int>, 4> p_queue;
+				p_queue.emplace(2, 1, 2);
+				p_queue.emplace(1, 3, 4);
+
+				failpass("Emplace test", p_queue.front().first == 3 && p_queue.front_level() == 1);
+			#endif
+		}
+	}
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
@@ -0,0 +1,207 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_LOCKED_QUEUE_H
+#define PLF_LOCKED_QUEUE_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_LOCKED_QUEUE_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+
+#include <cstddef> // std::size_t
+#include <mutex> // std::mutex, std::lock_guard
+#include <utility> // std::forward, std::move
+
+#include "plf_queue.h"
+
+
+
+namespace plf
+{
+
+
+// plf::locked_queue is a multiple-producer queue where producers push under a short lock, and the consumer takes every queued element at once with take_all(), which swaps the internal plf::queue out in O(1) and processes it outside of the lock.
+// A plf::queue which has been popped until empty still holds it's groups. Passing such a queue to take_all(destination), or handing one back via recycle(), gives those groups to the producers, so in steady state neither side allocates.
+// mutex_type may be any BasicLockable type, eg. a spinlock where the critical sections are expected to be very short. Queues handed over by take_all(destination) or recycle() are reshaped to the locked_queue's block capacity limits before the producers get them, so the limits supplied to the constructor always apply to pushes.
+
+template <class element_type, plf::priority priority = plf::memory_use, class mutex_type = std::mutex>
+class locked_queue
+{
+public:
+	typedef element_type								value_type;
+	typedef std::size_t								size_type;
+	typedef plf::queue<element_type, priority>	queue_type;
+
+private:
+	mutable mutex_type	mutex;
+	queue_type				elements;
+	queue_type				spare; // a drained queue handed back by recycle(), swapped in by take_all()
+	const size_type		min_block_capacity, max_block_capacity; // plf::queue::swap exchanges block limits along with groups, so these are reapplied to every queue given to the producers
+
+public:
+
+	locked_queue():
+		min_block_capacity(queue_type::default_min_block_capacity()),
+		max_block_capacity(queue_type::default_max_block_capacity())
+	{}
+
+
+
+	locked_queue(const size_type min, const size_type max = queue_type::default_max_block_capacity()):
+		elements(min, max),
+		spare(min, max),
+		min_block_capacity(min),
+		max_block_capacity(max)
+	{}
+
+
+
+	locked_queue(const locked_queue &source) = delete;
+	locked_queue & operator = (const locked_queue &source) = delete;
+
+
+
+	void push(const element_type &element)
+	{
+		std::lock_guard<mutex_type> lock(mutex);
+		elements.push(element);
+	}
+
+
+
+	void push(element_type &&element)
+	{
+		std::lock_guard<mutex_type> lock(mutex);
+		elements.push(std::move(element));
+	}
+
+
+
+	// Note: the element is constructed under the lock, so expensive constructions are better done beforehand and pushed by move:
+	template<typename... arguments>
+	void emplace(arguments &&... parameters)
+	{
+		std::lock_guard<mutex_type> lock(mutex);
+		elements.emplace(std::forward<arguments>(parameters)...);
+	}
+
+
+
+	// Moves every queued element into destination and returns the number taken. destination's groups are given to the producers in exchange - any elements still in destination are popped first, rather than cleared, so that it's groups are kept. destination ends up with the locked_queue's block capacity limits:
+	size_type take_all(queue_type &destination)
+	{
+		while (!destination.empty())
+		{
+			destination.pop();
+		}
+
+		destination.reshape(min_block_capacity, max_block_capacity);
+
+		{
+			std::lock_guard<mutex_type> lock(mutex);
+			elements.swap(destination);
+		}
+
+		return destination.size();
+	}
+
+
+
+	// Returns every queued element. The producers are given the groups from the last recycle()'d queue, if any:
+	queue_type take_all()
+	{
+		queue_type result(min_block_capacity, max_block_capacity);
+		std::lock_guard<mutex_type> lock(mutex);
+		result.swap(elements);
+		elements.swap(spare);
+		return result;
+	}
+
+
+
+	// Hands a drained queue (ie. one returned by take_all() and popped until empty) back for reuse by the next take_all(). drained is left untouched if it is not empty, or if a queue is already held for reuse:
+	void recycle(queue_type &&drained)
+	{
+		if (!drained.empty()) return;
+
+		std::lock_guard<mutex_type> lock(mutex);
+
+		if (spare.capacity() == 0)
+		{
+			spare.swap(drained);
+			spare.reshape(min_block_capacity, max_block_capacity); // as spare is empty, this only deallocates groups outside the limits
+		}
+	}
+
+
+
+	void reserve(const size_type reserve_amount)
+	{
+		std::lock_guard<mutex_type> lock(mutex);
+		elements.reserve(reserve_amount);
+	}
+
+
+
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() const
+	{
+		std::lock_guard<mutex_type> lock(mutex);
+		return elements.empty();
+	}
+
+
+
+	size_type size() const
+	{
+		std::lock_guard<mutex_type> lock(mutex);
+		return elements.size();
+	}
+
+
+
+	void clear()
+	{
+		std::lock_guard<mutex_type> lock(mutex);
+		elements.clear();
+		spare.clear();
+	}
+}; // locked_queue
+
+
+} // plf namespace
+
+
+#endif // PLF_VARIADICS_SUPPORT etc
+
+
+#ifdef PLF_LOCKED_QUEUE_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_LOCKED_QUEUE_H
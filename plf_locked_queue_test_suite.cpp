@@ -0,0 +1,287 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+#include <string> // std::string elements
+
+#include "plf_locked_queue.h"
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+	#include <atomic> // std::atomic_flag
+	#include <thread> // std::thread, std::this_thread::yield
+	#include <utility> // std::move
+	#include <vector> // per-producer bookkeeping
+#endif
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+	class spinlock
+	{
+	private:
+		std::atomic_flag flag;
+
+	public:
+		spinlock()
+		{
+			flag.clear();
+		}
+
+		void lock()
+		{
+			while (flag.test_and_set(std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		void unlock()
+		{
+			flag.clear(std::memory_order_release);
+		}
+	};
+
+
+	struct tagged_value
+	{
+		unsigned int producer, sequence;
+
+		tagged_value(const unsigned int source, const unsigned int number): producer(source), sequence(number) {}
+	};
+
+
+	typedef plf::locked_queue<tagged_value, plf::memory_use, spinlock> tagged_queue;
+
+
+	void produce(tagged_queue *l_queue, const unsigned int producer_number, const unsigned int count)
+	{
+		for (unsigned int counter = 0; counter != count; ++counter)
+		{
+			l_queue->emplace(producer_number, counter);
+		}
+	}
+#endif
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+		unsigned int looper = 0;
+
+		while (++looper != 25)
+		{
+			{
+				title1("Test basics");
+
+				locked_queue<int> l_queue(64, 64);
+				plf::queue<int> batch(64, 64);
+
+				failpass("Empty test", l_queue.empty() && l_queue.size() == 0 && l_queue.take_all(batch) == 0);
+
+				for (int counter = 0; counter != 100; ++counter)
+				{
+					l_queue.push(counter);
+				}
+
+				failpass("Push test", l_queue.size() == 100);
+
+				failpass("Take all test", l_queue.take_all(batch) == 100 && l_queue.empty() && batch.front() == 0 && batch.back() == 99);
+
+				int total = 0;
+
+				while (!batch.empty())
+				{
+					total += batch.front();
+					batch.pop();
+				}
+
+				const std::size_t drained_capacity = batch.capacity();
+
+				failpass("Drained batch keeps groups test", total == 4950 && drained_capacity != 0);
+
+				l_queue.emplace(5);
+				l_queue.take_all(batch);
+
+				failpass("Groups given to producers test", batch.size() == 1 && batch.front() == 5);
+
+				batch.push(6);
+
+				const std::size_t batch_capacity = batch.capacity();
+
+				failpass("Non-empty destination emptied test", l_queue.take_all(batch) == 0 && batch.empty());
+
+				l_queue.push(13);
+				l_queue.take_all(batch);
+
+				failpass("Non-empty destination keeps groups test", batch.size() == 1 && batch.front() == 13 && batch.capacity() == batch_capacity);
+
+				batch.pop();
+
+				l_queue.push(7);
+				l_queue.take_all(batch);
+				batch.pop();
+				l_queue.push(8);
+
+				plf::queue<int> taken = l_queue.take_all();
+
+				failpass("Take all by value test", taken.size() == 1 && taken.front() == 8 && l_queue.empty());
+
+				taken.pop();
+				const std::size_t taken_capacity = taken.capacity();
+				l_queue.recycle(std::move(taken));
+
+				failpass("Recycle test", taken.capacity() == 0);
+
+				l_queue.push(9);
+				plf::queue<int> taken2 = l_queue.take_all();
+				l_queue.push(10);
+				plf::queue<int> taken3 = l_queue.take_all();
+
+				failpass("Recycled groups reused test", taken2.front() == 9 && taken3.front() == 10 && taken3.capacity() == taken_capacity);
+
+				taken3.push(11);
+				l_queue.recycle(std::move(taken3));
+
+				failpass("Non-empty recycle ignored test", taken3.size() == 2 && taken3.back() == 11);
+
+				l_queue.reserve(1000);
+				l_queue.push(12);
+				l_queue.clear();
+
+				failpass("Clear test", l_queue.empty() && l_queue.take_all().capacity() == 0);
+			}
+
+
+			{
+				title2("Block capacity limit tests");
+
+				locked_queue<int> l_queue(500, 500);
+				bool limits_kept = true;
+
+				for (int round = 0; round != 5; ++round)
+				{
+					for (int counter = 0; counter != 1000; ++counter)
+					{
+						l_queue.push(counter);
+					}
+
+					plf::queue<int> taken = l_queue.take_all();
+					limits_kept = limits_kept && taken.size() == 1000 && taken.capacity() == 1000;
+
+					if (round % 2 == 0) // half the time hand the groups back
+					{
+						while (!taken.empty())
+						{
+							taken.pop();
+						}
+
+						l_queue.recycle(std::move(taken));
+					}
+				}
+
+				failpass("Limits kept across take_all test", limits_kept);
+
+				plf::queue<int> small_batch(8, 8);
+
+				for (int counter = 0; counter != 100; ++counter)
+				{
+					small_batch.push(counter);
+				}
+
+				l_queue.take_all(small_batch); // small_batch's 8-element groups are outside the limits, so must not reach the producers
+
+				for (int counter = 0; counter != 1000; ++counter)
+				{
+					l_queue.push(counter);
+				}
+
+				plf::queue<int> taken = l_queue.take_all();
+
+				failpass("Destination limits not given to producers test", taken.size() == 1000 && taken.capacity() == 1000);
+			}
+
+
+			{
+				title2("Multiple producer tests");
+
+				const unsigned int producer_count = 6, per_producer = 20000;
+				tagged_queue l_queue(256, 256);
+				std::vector<std::thread> producers;
+
+				for (unsigned int producer_number = 0; producer_number != producer_count; ++producer_number)
+				{
+					producers.push_back(std::thread(produce, &l_queue, producer_number, per_producer));
+				}
+
+				std::vector<unsigned int> next_expected(producer_count, 0);
+				plf::queue<tagged_value> batch(256, 256);
+				unsigned int received = 0;
+				bool in_order = true;
+
+				while (received != producer_count * per_producer && in_order)
+				{
+					if (l_queue.take_all(batch) == 0)
+					{
+						std::this_thread::yield();
+						continue;
+					}
+
+					for (; !batch.empty() && in_order; batch.pop(), ++received)
+					{
+						in_order = batch.front().producer < producer_count && batch.front().sequence == next_expected[batch.front().producer]++;
+					}
+				}
+
+				for (std::vector<std::thread>::iterator current = producers.begin(); current != producers.end(); ++current)
+				{
+					current->join();
+				}
+
+				failpass("Per-producer FIFO order test", in_order);
+				failpass("All elements received test", received == producer_count * per_producer && l_queue.empty());
+			}
+		}
+	#endif
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
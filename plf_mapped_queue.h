@@ -0,0 +1,796 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_MAPPED_QUEUE_H
+#define PLF_MAPPED_QUEUE_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_MAPPED_QUEUE_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT) && (defined(__unix__) || (defined(__APPLE__) && defined(__MACH__)))
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t, offsetof
+#include <cstdint> // std::uint64_t
+#include <limits>  // std::numeric_limits
+#include <new> // placement new
+#include <stdexcept> // std::length_error, std::runtime_error
+#include <type_traits> // std::is_trivially_copyable
+#include <utility> // std::forward, std::swap
+#include <vector> // retired groups
+
+#include <fcntl.h> // open
+#include <sys/mman.h> // mmap, munmap, msync
+#include <sys/stat.h> // fstat
+#include <unistd.h> // close, ftruncate, sysconf
+
+
+
+namespace plf
+{
+
+
+// plf::mapped_queue is a durable FIFO queue for trivially copyable types, whose groups live in a memory-mapped file. The group chain is linked by file offsets.
+// The file starts with two alternating header slots, recording the first and current group offsets and the start and top element indices. Each slot has a sequence number and checksum.
+// sync() is a durability point. It checksums the groups written since the previous sync(), msyncs the element data, then writes and msyncs the next header slot. set_sync_interval() makes push/pop call sync() every n operations.
+// On opening an existing file, the newest valid header slot is used, and the group chain is scanned from the front, validating each group's checksum. The queue is truncated before the first invalid group.
+// Popped groups are only reused after the next sync(), so that the state recorded by the previous durability point is never overwritten. Group space which is unreachable after a crash is not reclaimed until clear().
+// front()/back() references are invalidated by any push which grows the file.
+
+template <class element_type>
+class mapped_queue
+{
+public:
+	typedef element_type			value_type;
+	typedef std::size_t			size_type;
+	typedef const element_type &	const_reference;
+
+private:
+	static_assert(std::is_trivially_copyable<element_type>::value, "plf::mapped_queue requires a trivially copyable element type");
+	static_assert(alignof(element_type) <= 64, "plf::mapped_queue does not support element types with alignment greater than 64");
+
+	typedef std::uint64_t offset_type;
+
+	struct file_header // one of the two alternating slots at the start of the file
+	{
+		std::uint64_t	magic, sequence, element_size, first_offset, current_offset, start_index, top_index, total_size, end_offset, checksum;
+	};
+
+
+	struct group_header // at the start of each group in the file, followed by the elements
+	{
+		std::uint64_t	next_offset, capacity;
+		std::uint64_t	used[2], checksum[2]; // written by sync(), covering elements [0, used). Indexed by the header slot, so that a sync() interrupted by a crash does not invalidate the previous durability point's values
+	};
+
+
+	static const std::uint64_t	file_magic = 0x31515044454D4C50ULL; // "PLMDQPQ1"
+	static const std::uint64_t	empty_checksum = 0xCBF29CE484222325ULL; // FNV-1a offset basis, ie. the checksum of zero bytes
+	static const size_type		slot_size = 128, header_area_size = 256, group_header_size = 64, group_alignment = 64;
+
+	int					file_descriptor;
+	unsigned char		*mapping;
+	size_type			mapped_size;
+	offset_type			first_offset, current_offset;
+	size_type			start_index, top_index, total_size, total_capacity, end_offset; // end_offset is the end of the space used by groups in the file
+	size_type			min_block_capacity, max_block_capacity;
+	std::uint64_t		sequence;
+	size_type			sync_interval, operations_since_sync, discarded_elements;
+	std::vector<offset_type>	retired_groups; // popped groups awaiting the next sync() before they can be reused
+
+
+
+	static std::uint64_t checksum(const void * const data, const size_type bytes) PLF_NOEXCEPT // 64-bit FNV-1a
+	{
+		const unsigned char *current = static_cast<const unsigned char *>(data), * const end = current + bytes;
+		std::uint64_t hash = empty_checksum;
+
+		for (; current != end; ++current)
+		{
+			hash = (hash ^ *current) * 0x100000001B3ULL;
+		}
+
+		return hash;
+	}
+
+
+
+	static void throw_error(const char * const message)
+	{
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			throw std::runtime_error(message);
+		#else
+			static_cast<void>(message);
+			std::terminate();
+		#endif
+	}
+
+
+
+	void check_capacities_conformance(const size_type min, const size_type max) const
+	{
+		if (min < 2 || min > max || max > (std::numeric_limits<size_type>::max() / (sizeof(element_type) * 4)))
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::length_error("Supplied memory block capacities outside of allowable ranges");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+
+	group_header * group_at(const offset_type offset) const PLF_NOEXCEPT
+	{
+		return reinterpret_cast<group_header *>(mapping + offset);
+	}
+
+
+
+	element_type * elements_of(const offset_type offset) const PLF_NOEXCEPT
+	{
+		return reinterpret_cast<element_type *>(mapping + offset + group_header_size);
+	}
+
+
+
+	file_header * slot_at(const std::uint64_t slot_sequence) const PLF_NOEXCEPT
+	{
+		return reinterpret_cast<file_header *>(mapping + ((slot_sequence & 1) * slot_size));
+	}
+
+
+
+	static size_type group_bytes(const size_type capacity) PLF_NOEXCEPT
+	{
+		return (group_header_size + (capacity * sizeof(element_type)) + (group_alignment - 1)) & ~(group_alignment - 1);
+	}
+
+
+
+	void map_file(const size_type size)
+	{
+		void * const address = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+
+		if (address == MAP_FAILED)
+		{
+			mapping = NULL;
+			mapped_size = 0;
+			throw_error("plf::mapped_queue: could not map the queue file");
+		}
+
+		mapping = static_cast<unsigned char *>(address);
+		mapped_size = size;
+	}
+
+
+
+	void ensure_file_size(const size_type required_size)
+	{
+		if (required_size <= mapped_size) return;
+
+		const size_type page_size = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+		size_type new_size = (mapped_size * 2 > required_size) ? mapped_size * 2 : required_size;
+		new_size = (new_size + (page_size - 1)) & ~(page_size - 1);
+
+		if (::ftruncate(file_descriptor, static_cast<off_t>(new_size)) != 0)
+		{
+			throw_error("plf::mapped_queue: could not extend the queue file");
+		}
+
+		if (mapping != NULL)
+		{
+			::munmap(mapping, mapped_size);
+			mapping = NULL;
+		}
+
+		map_file(new_size);
+	}
+
+
+
+	offset_type allocate_group(const size_type capacity)
+	{
+		const offset_type offset = end_offset;
+		ensure_file_size(end_offset + group_bytes(capacity));
+		end_offset += group_bytes(capacity);
+
+		group_header * const new_group = group_at(offset);
+		new_group->next_offset = 0;
+		new_group->capacity = capacity;
+		new_group->used[0] = new_group->used[1] = 0;
+		new_group->checksum[0] = new_group->checksum[1] = empty_checksum;
+		total_capacity += capacity;
+		return offset;
+	}
+
+
+
+	void initialize_file()
+	{
+		end_offset = header_area_size;
+		ensure_file_size(header_area_size + group_bytes(min_block_capacity));
+		first_offset = current_offset = allocate_group(min_block_capacity);
+		start_index = top_index = total_size = 0;
+		sync();
+	}
+
+
+
+	void progress_to_next_group()
+	{
+		group_header *current_group = group_at(current_offset);
+
+		if (current_group->next_offset == 0) // no reserved groups or groups left over from previous pops, allocate new group
+		{
+			// Same logic as plf::queue - see plf_queue.h:
+			const size_type current_capacity = static_cast<size_type>(current_group->capacity);
+			const size_type divided_size = total_size / plf::memory_use;
+			const size_type new_group_capacity = ((divided_size < (current_capacity * 2)) & (divided_size > (current_capacity / 2))) ? current_capacity :
+															(divided_size < min_block_capacity) ? min_block_capacity :
+															(divided_size > max_block_capacity) ? max_block_capacity : divided_size;
+
+			const offset_type new_offset = allocate_group(new_group_capacity);
+			current_group = group_at(current_offset); // mapping may have moved
+			current_group->next_offset = new_offset;
+		}
+
+		current_offset = current_group->next_offset;
+		top_index = 0;
+
+		group_header * const next_group = group_at(current_offset); // may be a reused group, whose previous contents are no longer valid
+		next_group->used[0] = next_group->used[1] = 0;
+		next_group->checksum[0] = next_group->checksum[1] = empty_checksum;
+	}
+
+
+
+	void count_operation()
+	{
+		if (sync_interval != 0 && ++operations_since_sync >= sync_interval)
+		{
+			sync();
+		}
+	}
+
+
+
+	bool recover() // returns false if the file has no valid header
+	{
+		if (mapped_size < header_area_size) return false;
+
+		const file_header *header = NULL;
+
+		for (std::uint64_t slot = 0; slot != 2; ++slot)
+		{
+			const file_header * const candidate = slot_at(slot);
+
+			if (candidate->magic == file_magic && candidate->checksum == checksum(candidate, offsetof(file_header, checksum)) && candidate->end_offset <= mapped_size && (header == NULL || candidate->sequence > header->sequence))
+			{
+				header = candidate;
+			}
+		}
+
+		if (header == NULL) return false;
+
+		if (header->element_size != sizeof(element_type))
+		{
+			throw_error("plf::mapped_queue: the queue file was written with a different element type");
+		}
+
+		sequence = header->sequence;
+		end_offset = static_cast<size_type>(header->end_offset);
+		first_offset = header->first_offset;
+		current_offset = header->current_offset;
+		start_index = static_cast<size_type>(header->start_index);
+		top_index = static_cast<size_type>(header->top_index);
+
+		const size_type recorded_size = static_cast<size_type>(header->total_size);
+		const size_type slot = static_cast<size_type>(sequence & 1);
+		offset_type last_valid_offset = 0, offset = first_offset;
+		size_type last_valid_top = 0;
+		total_size = 0;
+
+		while (true) // Scan the chain from the front, stopping at the first group which fails validation
+		{
+			if (offset < header_area_size || offset % group_alignment != 0 || offset + group_header_size > end_offset) break;
+
+			const group_header * const current_group = group_at(offset);
+			const size_type limit = (offset == current_offset) ? top_index : static_cast<size_type>(current_group->capacity);
+			const size_type first = (offset == first_offset) ? start_index : 0;
+
+			if (current_group->capacity == 0 || current_group->capacity > (end_offset - offset) / sizeof(element_type) || offset + group_bytes(static_cast<size_type>(current_group->capacity)) > end_offset ||
+				current_group->used[slot] > current_group->capacity || current_group->used[slot] < limit || first > limit ||
+				checksum(elements_of(offset), static_cast<size_type>(current_group->used[slot]) * sizeof(element_type)) != current_group->checksum[slot])
+			{
+				break;
+			}
+
+			total_size += limit - first;
+			last_valid_offset = offset;
+			last_valid_top = limit;
+
+			if (offset == current_offset) break;
+
+			offset = current_group->next_offset;
+		}
+
+		if (last_valid_offset == 0) // front group is invalid - restart with an empty queue
+		{
+			first_offset = current_offset = allocate_group(min_block_capacity);
+			start_index = top_index = total_size = 0;
+		}
+		else
+		{
+			current_offset = last_valid_offset;
+			top_index = last_valid_top;
+			group_at(current_offset)->next_offset = 0; // groups after current_group may have been partially written since the durability point
+		}
+
+		discarded_elements = (recorded_size > total_size) ? recorded_size - total_size : 0;
+
+		total_capacity = 0;
+
+		for (offset_type current = first_offset; current != 0; current = group_at(current)->next_offset)
+		{
+			total_capacity += static_cast<size_type>(group_at(current)->capacity);
+		}
+
+		sync();
+		return true;
+	}
+
+
+
+	void open_file(const char * const path)
+	{
+		file_descriptor = ::open(path, O_RDWR | O_CREAT, 0644);
+
+		if (file_descriptor == -1)
+		{
+			throw_error("plf::mapped_queue: could not open the queue file");
+		}
+
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			try
+			{
+		#endif
+				struct stat file_status;
+
+				if (::fstat(file_descriptor, &file_status) != 0)
+				{
+					throw_error("plf::mapped_queue: could not read the size of the queue file");
+				}
+
+				if (file_status.st_size != 0)
+				{
+					map_file(static_cast<size_type>(file_status.st_size));
+				}
+
+				if (file_status.st_size == 0 || !recover())
+				{
+					if (file_status.st_size != 0)
+					{
+						throw_error("plf::mapped_queue: the file is not a plf::mapped_queue file, or both it's headers are corrupt");
+					}
+
+					initialize_file();
+				}
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			}
+			catch (...)
+			{
+				close_file();
+				throw;
+			}
+		#endif
+	}
+
+
+
+	void close_file() PLF_NOEXCEPT
+	{
+		if (mapping != NULL)
+		{
+			::munmap(mapping, mapped_size);
+		}
+
+		if (file_descriptor != -1)
+		{
+			::close(file_descriptor);
+		}
+
+		blank();
+	}
+
+
+
+	void blank() PLF_NOEXCEPT
+	{
+		file_descriptor = -1;
+		mapping = NULL;
+		mapped_size = 0;
+		first_offset = current_offset = 0;
+		start_index = top_index = total_size = total_capacity = end_offset = 0;
+		sequence = 0;
+		operations_since_sync = discarded_elements = 0;
+		retired_groups.clear();
+	}
+
+
+
+public:
+
+	static PLF_CONSTFUNC size_type default_min_block_capacity() PLF_NOEXCEPT
+	{
+		return (sizeof(element_type) > 512) ? 8 : 4096 / sizeof(element_type);
+	}
+
+
+
+	static PLF_CONSTFUNC size_type default_max_block_capacity() PLF_NOEXCEPT
+	{
+		return (sizeof(element_type) > 1024) ? 256 : 262144 / sizeof(element_type);
+	}
+
+
+
+	// Opens the queue file at path, creating it if it does not exist, or recovering it's contents if it does:
+	explicit mapped_queue(const char * const path, const size_type min = default_min_block_capacity(), const size_type max = default_max_block_capacity()):
+		file_descriptor(-1),
+		mapping(NULL),
+		mapped_size(0),
+		first_offset(0),
+		current_offset(0),
+		start_index(0),
+		top_index(0),
+		total_size(0),
+		total_capacity(0),
+		end_offset(0),
+		min_block_capacity(min),
+		max_block_capacity(max),
+		sequence(0),
+		sync_interval(0),
+		operations_since_sync(0),
+		discarded_elements(0)
+	{
+		check_capacities_conformance(min, max);
+		open_file(path);
+	}
+
+
+
+	mapped_queue(const mapped_queue &source) = delete;
+	mapped_queue & operator = (const mapped_queue &source) = delete;
+
+
+
+	mapped_queue(mapped_queue &&source) PLF_NOEXCEPT:
+		file_descriptor(-1),
+		mapping(NULL),
+		mapped_size(0),
+		first_offset(0),
+		current_offset(0),
+		start_index(0),
+		top_index(0),
+		total_size(0),
+		total_capacity(0),
+		end_offset(0),
+		min_block_capacity(source.min_block_capacity),
+		max_block_capacity(source.max_block_capacity),
+		sequence(0),
+		sync_interval(0),
+		operations_since_sync(0),
+		discarded_elements(0)
+	{
+		swap(source);
+	}
+
+
+
+	mapped_queue & operator = (mapped_queue &&source) PLF_NOEXCEPT
+	{
+		assert(&source != this);
+
+		close();
+		swap(source);
+		return *this;
+	}
+
+
+
+	~mapped_queue() PLF_NOEXCEPT
+	{
+		close();
+	}
+
+
+
+	void push(const element_type &element)
+	{
+		if (top_index == group_at(current_offset)->capacity)
+		{
+			progress_to_next_group();
+		}
+
+		if (total_size == 0 && first_offset != current_offset) // ie. queue was emptied at the end of a group
+		{
+			retired_groups.push_back(first_offset);
+			first_offset = current_offset;
+			start_index = top_index;
+		}
+
+		::new (static_cast<void *>(elements_of(current_offset) + top_index++)) element_type(element);
+		++total_size;
+		count_operation();
+	}
+
+
+
+	template<typename... arguments>
+	void emplace(arguments &&... parameters)
+	{
+		push(element_type(std::forward<arguments>(parameters)...));
+	}
+
+
+
+	const_reference front() const PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+		return elements_of(first_offset)[start_index];
+	}
+
+
+
+	const_reference back() const PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+		return elements_of(current_offset)[top_index - 1];
+	}
+
+
+
+	// Advances the head. The new head position is persisted at the next sync():
+	void pop()
+	{
+		assert(total_size != 0);
+
+		--total_size;
+
+		if (++start_index == group_at(first_offset)->capacity && first_offset != current_offset) // Unlike plf::queue, indexes are not reset when the queue becomes empty, as that would overwrite the data recorded by the last durability point
+		{
+			retired_groups.push_back(first_offset);
+			first_offset = group_at(first_offset)->next_offset;
+			start_index = 0;
+		}
+
+		count_operation();
+	}
+
+
+
+	// Durability point - once this returns, the current contents of the queue will be recovered if the process or system subsequently crashes:
+	void sync()
+	{
+		if (mapping == NULL) return;
+
+		const size_type previous_slot = static_cast<size_type>(sequence & 1), next_slot = previous_slot ^ 1;
+
+		for (offset_type offset = first_offset; ; offset = group_at(offset)->next_offset) // Checksum groups which have changed since the last sync
+		{
+			group_header * const current_group = group_at(offset);
+			const std::uint64_t used = (offset == current_offset) ? top_index : current_group->capacity;
+
+			current_group->checksum[next_slot] = (current_group->used[previous_slot] == used) ? current_group->checksum[previous_slot] : checksum(elements_of(offset), static_cast<size_type>(used) * sizeof(element_type));
+			current_group->used[next_slot] = used;
+
+			if (offset == current_offset) break;
+		}
+
+		if (::msync(mapping, mapped_size, MS_SYNC) != 0)
+		{
+			throw_error("plf::mapped_queue: msync failed");
+		}
+
+		file_header * const header = slot_at(++sequence);
+		header->magic = file_magic;
+		header->sequence = sequence;
+		header->element_size = sizeof(element_type);
+		header->first_offset = first_offset;
+		header->current_offset = current_offset;
+		header->start_index = start_index;
+		header->top_index = top_index;
+		header->total_size = total_size;
+		header->end_offset = end_offset;
+		header->checksum = checksum(header, offsetof(file_header, checksum));
+
+		if (::msync(mapping, header_area_size, MS_SYNC) != 0)
+		{
+			throw_error("plf::mapped_queue: msync failed");
+		}
+
+		// The previous durability point no longer refers to the retired groups, so they can be reused:
+		group_header * const current_group = group_at(current_offset);
+
+		for (typename std::vector<offset_type>::iterator current = retired_groups.begin(); current != retired_groups.end(); ++current)
+		{
+			group_at(*current)->next_offset = current_group->next_offset;
+			current_group->next_offset = *current;
+		}
+
+		retired_groups.clear();
+		operations_since_sync = 0;
+	}
+
+
+
+	// push/pop call sync() every interval operations. 0 means sync() is only called explicitly, and on close:
+	void set_sync_interval(const size_type interval) PLF_NOEXCEPT
+	{
+		sync_interval = interval;
+	}
+
+
+
+	// Syncs and closes the file. The queue is empty and unusable afterwards:
+	void close() PLF_NOEXCEPT
+	{
+		if (mapping != NULL)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				try
+				{
+					sync();
+				}
+				catch (...)
+				{}
+			#else
+				sync();
+			#endif
+		}
+
+		close_file();
+	}
+
+
+
+	// Removes all elements and shrinks the file back to a single group:
+	void clear()
+	{
+		assert(mapping != NULL);
+
+		::munmap(mapping, mapped_size);
+		mapping = NULL;
+		mapped_size = 0;
+		total_capacity = 0;
+		retired_groups.clear();
+
+		if (::ftruncate(file_descriptor, 0) != 0)
+		{
+			throw_error("plf::mapped_queue: could not truncate the queue file");
+		}
+
+		initialize_file();
+	}
+
+
+
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() const PLF_NOEXCEPT
+	{
+		return total_size == 0;
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return total_size;
+	}
+
+
+
+	size_type capacity() const PLF_NOEXCEPT
+	{
+		return total_capacity;
+	}
+
+
+
+	size_type file_size() const PLF_NOEXCEPT
+	{
+		return mapped_size;
+	}
+
+
+
+	// Number of elements recorded by the last durability point before opening, which failed checksum validation and were discarded:
+	size_type discarded_on_open() const PLF_NOEXCEPT
+	{
+		return discarded_elements;
+	}
+
+
+
+	void reshape(const size_type min, const size_type max)
+	{
+		check_capacities_conformance(min, max);
+		min_block_capacity = min;
+		max_block_capacity = max;
+	}
+
+
+
+	void swap(mapped_queue &source) PLF_NOEXCEPT
+	{
+		std::swap(file_descriptor, source.file_descriptor);
+		std::swap(mapping, source.mapping);
+		std::swap(mapped_size, source.mapped_size);
+		std::swap(first_offset, source.first_offset);
+		std::swap(current_offset, source.current_offset);
+		std::swap(start_index, source.start_index);
+		std::swap(top_index, source.top_index);
+		std::swap(total_size, source.total_size);
+		std::swap(total_capacity, source.total_capacity);
+		std::swap(end_offset, source.end_offset);
+		std::swap(min_block_capacity, source.min_block_capacity);
+		std::swap(max_block_capacity, source.max_block_capacity);
+		std::swap(sequence, source.sequence);
+		std::swap(sync_interval, source.sync_interval);
+		std::swap(operations_since_sync, source.operations_since_sync);
+		std::swap(discarded_elements, source.discarded_elements);
+		retired_groups.swap(source.retired_groups);
+	}
+}; // mapped_queue
+
+
+} // plf namespace
+
+
+
+namespace std
+{
+
+template <class element_type>
+void swap (plf::mapped_queue<element_type> &a, plf::mapped_queue<element_type> &b) PLF_NOEXCEPT
+{
+	a.swap(b);
+}
+
+}
+
+
+#endif // PLF_VARIADICS_SUPPORT etc
+
+
+#ifdef PLF_MAPPED_QUEUE_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_MAPPED_QUEUE_H
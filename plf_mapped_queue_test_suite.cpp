@@ -0,0 +1,262 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+#include <fstream> // file copying and corruption
+
+#include "plf_mapped_queue.h"
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT) && (defined(__unix__) || (defined(__APPLE__) && defined(__MACH__)))
+	#define PLF_MAPPED_QUEUE_TESTS
+
+	// Copies the file's current contents, as a crash would leave them:
+	void copy_file(const char *source, const char *destination)
+	{
+		std::ifstream input(source, std::ios::binary);
+		std::ofstream output(destination, std::ios::binary | std::ios::trunc);
+		output << input.rdbuf();
+	}
+
+
+
+	void corrupt_byte(const char *path, const long offset)
+	{
+		std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekg(offset);
+		const char value = static_cast<char>(file.get() ^ 0x5A);
+		file.seekp(offset);
+		file.put(value);
+	}
+#endif
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	#ifdef PLF_MAPPED_QUEUE_TESTS
+		const char *path = "plf_mapped_queue_test.dat", *copy_path = "plf_mapped_queue_test_copy.dat";
+		unsigned int looper = 0;
+
+		while (++looper != 10)
+		{
+			std::remove(path);
+			std::remove(copy_path);
+
+			{
+				title1("Test basics");
+
+				{
+					mapped_queue<unsigned int> m_queue(path);
+
+					failpass("Empty test", m_queue.empty() && m_queue.discarded_on_open() == 0);
+
+					for (unsigned int temp = 0; temp != 100000; ++temp)
+					{
+						m_queue.push(temp);
+					}
+
+					for (unsigned int temp = 0; temp != 1000; ++temp)
+					{
+						m_queue.pop();
+					}
+
+					failpass("Size test", m_queue.size() == 99000);
+					failpass("Front/back test", m_queue.front() == 1000 && m_queue.back() == 99999);
+				}
+
+				mapped_queue<unsigned int> m_queue(path);
+
+				failpass("Reopen size test", m_queue.size() == 99000 && m_queue.discarded_on_open() == 0);
+				failpass("Reopen front/back test", m_queue.front() == 1000 && m_queue.back() == 99999);
+
+				bool contents_correct = true;
+
+				for (unsigned int temp = 1000; temp != 100000; ++temp)
+				{
+					contents_correct = contents_correct && m_queue.front() == temp;
+					m_queue.pop();
+				}
+
+				failpass("Reopen contents test", contents_correct && m_queue.empty());
+
+				m_queue.emplace(5u);
+
+				failpass("Post-empty push test", m_queue.front() == 5 && m_queue.size() == 1);
+
+				m_queue.clear();
+
+				failpass("Clear test", m_queue.empty() && m_queue.file_size() < 100000);
+			}
+
+			{
+				title2("Durability point tests");
+
+				mapped_queue<unsigned int> m_queue(path, 64, 64);
+				m_queue.set_sync_interval(100);
+
+				for (unsigned int temp = 0; temp != 1000; ++temp)
+				{
+					m_queue.push(temp);
+				}
+
+				m_queue.sync();
+				m_queue.set_sync_interval(0);
+
+				for (unsigned int temp = 0; temp != 500; ++temp) // pop without a durability point, then push - which would overwrite the popped groups if they were reused before the next sync
+				{
+					m_queue.pop();
+				}
+
+				for (unsigned int temp = 1000; temp != 1100; ++temp)
+				{
+					m_queue.push(temp);
+				}
+
+				copy_file(path, copy_path);
+
+				{
+					mapped_queue<unsigned int> crashed_queue(copy_path, 64, 64);
+
+					failpass("Crash recovery size test", crashed_queue.size() == 1000 && crashed_queue.discarded_on_open() == 0);
+					failpass("Crash recovery front/back test", crashed_queue.front() == 0 && crashed_queue.back() == 999);
+
+					bool contents_correct = true;
+
+					for (unsigned int temp = 0; temp != 1000; ++temp)
+					{
+						contents_correct = contents_correct && crashed_queue.front() == temp;
+						crashed_queue.pop();
+					}
+
+					failpass("Crash recovery contents test", contents_correct);
+				}
+
+				std::remove(copy_path);
+
+				const std::size_t file_size = m_queue.file_size();
+				m_queue.set_sync_interval(64);
+
+				for (unsigned int counter = 0; counter != 100; ++counter)
+				{
+					for (unsigned int temp = 0; temp != 500; ++temp)
+					{
+						m_queue.push(temp);
+						m_queue.pop();
+					}
+				}
+
+				failpass("Group reuse test", m_queue.file_size() == file_size && m_queue.size() == 600);
+			}
+
+			{
+				title2("Corruption tests");
+
+				std::remove(path);
+
+				{
+					mapped_queue<unsigned int> m_queue(path, 64, 64);
+
+					for (unsigned int temp = 0; temp != 640; ++temp)
+					{
+						m_queue.push(temp);
+					}
+
+					m_queue.pop();
+				}
+
+				// Groups are 320 bytes each (64-byte header plus 64 elements), starting after the 256-byte file header. Corrupt the third group's elements:
+				corrupt_byte(path, 256 + (320 * 2) + 64 + 10);
+
+				{
+					mapped_queue<unsigned int> m_queue(path, 64, 64);
+
+					failpass("Truncation test", m_queue.size() == 127 && m_queue.discarded_on_open() == 512);
+					failpass("Truncated front/back test", m_queue.front() == 1 && m_queue.back() == 127);
+
+					m_queue.push(128);
+
+					failpass("Post-truncation push test", m_queue.back() == 128 && m_queue.size() == 128);
+				}
+
+				{
+					mapped_queue<unsigned int> m_queue(path, 64, 64);
+
+					failpass("Post-truncation reopen test", m_queue.size() == 128 && m_queue.discarded_on_open() == 0 && m_queue.back() == 128);
+
+					m_queue.push(129);
+					m_queue.sync();
+				}
+
+				// Corrupt both header slots' first_offset fields in turn. With only the older slot corrupt, the newer is used:
+				corrupt_byte(path, 24);
+
+				{
+					mapped_queue<unsigned int> m_queue(path, 64, 64);
+
+					failpass("Header slot test", m_queue.size() == 129 && m_queue.back() == 129);
+				}
+
+				corrupt_byte(path, 24);
+				corrupt_byte(path, 128 + 24);
+
+				bool thrown = false;
+
+				try
+				{
+					mapped_queue<unsigned int> m_queue(path, 64, 64);
+				}
+				catch (std::runtime_error &)
+				{
+					thrown = true;
+				}
+
+				failpass("Invalid file test", thrown);
+			}
+
+			std::remove(path);
+		}
+	#endif
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
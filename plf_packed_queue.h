@@ -0,0 +1,533 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_PACKED_QUEUE_H
+#define PLF_PACKED_QUEUE_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_PACKED_QUEUE_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#define PLF_INCLUDE_BIT_TOOLS
+#include "plf_tools.h"
+
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <limits>  // std::numeric_limits
+#include <utility> // std::swap
+
+#include "plf_queue_group_chain.h"
+
+
+
+namespace plf
+{
+
+
+// plf::packed_queue is a FIFO queue of bits-wide unsigned values (bool when bits == 1), packed into machine words within each group. Bits must be 1, 2, 4, 8, 16 or 32, so that elements never straddle words.
+// Group chain and group recycling behaviour matches plf::queue, though groups are always allocated with plain operator new and grow as per plf::memory_use (see plf::group_chain). Block capacities are in elements and are rounded up to a whole number of words.
+// count() and find() test a word's worth of elements at a time, using plf::popcount and plf::countr_zero.
+
+// A group of plf::packed_queue elements, bits wide, packed into the words following the group header:
+template <unsigned int bits>
+struct packed_group
+{
+	typedef std::size_t word_type;
+
+	static const std::size_t elements_per_word = (sizeof(word_type) * 8) / bits;
+
+	packed_group		*next_group, *previous_group;
+	const std::size_t	capacity; // in elements, always a multiple of elements_per_word
+
+	packed_group(const std::size_t elements, packed_group * const previous) PLF_NOEXCEPT:
+		next_group(NULL),
+		previous_group(previous),
+		capacity(elements)
+	{}
+
+	static PLF_CONSTFUNC std::size_t rounded_capacity(const std::size_t elements) PLF_NOEXCEPT
+	{
+		return (elements + (elements_per_word - 1)) & ~(elements_per_word - 1);
+	}
+
+	static PLF_CONSTFUNC std::size_t allocation_size(const std::size_t elements) PLF_NOEXCEPT
+	{
+		return sizeof(packed_group) + ((elements / elements_per_word) * sizeof(word_type));
+	}
+
+	word_type * words() PLF_NOEXCEPT
+	{
+		return reinterpret_cast<word_type *>(this + 1);
+	}
+};
+
+
+
+template <unsigned int bits>
+class packed_queue : private plf::group_chain<plf::packed_group<bits> >
+{
+public:
+	typedef typename plf::conditional<bits == 1, bool, unsigned int>::type	value_type;
+	typedef std::size_t																			size_type;
+
+private:
+	#ifdef PLF_CPP11_SUPPORT
+		static_assert(bits == 1 || bits == 2 || bits == 4 || bits == 8 || bits == 16 || bits == 32, "plf::packed_queue bits must be 1, 2, 4, 8, 16 or 32");
+	#endif
+
+	typedef plf::packed_group<bits>				group;
+	typedef plf::group_chain<group>				chain_type;
+	typedef typename group::word_type			word_type;
+
+	using chain_type::current_group;
+	using chain_type::first_group;
+	using chain_type::total_size;
+	using chain_type::total_capacity;
+	using chain_type::min_block_capacity;
+	using chain_type::max_block_capacity;
+	using chain_type::check_capacities_conformance;
+	using chain_type::initialize;
+	using chain_type::retire_first_group;
+	using chain_type::deallocate_all_groups;
+	using chain_type::groups_memory;
+	using chain_type::swap_chain;
+
+	static const size_type word_bits = sizeof(word_type) * 8;
+	static const size_type elements_per_word = group::elements_per_word;
+	static const word_type value_mask = (bits == word_bits) ? ~static_cast<word_type>(0) : (static_cast<word_type>(1) << (bits % word_bits)) - 1;
+
+	size_type		start_index, top_index; // index of the front element within first_group, and one-past the back element within current_group
+
+
+
+	// The bit pattern with the value repeated in every element of a word:
+	static word_type broadcast(const value_type value) PLF_NOEXCEPT
+	{
+		return (~static_cast<word_type>(0) / value_mask) * (static_cast<word_type>(value) & value_mask);
+	}
+
+
+
+	// Returns the highest bit of each element in the word which equals the broadcast pattern, and no other bits:
+	static word_type matching_elements(const word_type word, const word_type pattern) PLF_NOEXCEPT
+	{
+		const word_type high_bits = (~static_cast<word_type>(0) / value_mask) << (bits - 1);
+		const word_type low_bits = ~high_bits;
+		const word_type difference = word ^ pattern;
+		return ~(((difference & low_bits) + low_bits) | difference | low_bits); // exact zero-element test, no carries between elements
+	}
+
+
+
+	// Mask of the bits belonging to elements [first, last) within a single word:
+	static word_type element_range_mask(const size_type first, const size_type last) PLF_NOEXCEPT
+	{
+		const word_type upper = ((last - first) * bits == word_bits) ? ~static_cast<word_type>(0) : ((static_cast<word_type>(1) << ((last - first) * bits)) - 1);
+		return upper << (first * bits);
+	}
+
+
+
+	void progress_to_next_group() // used by push when current_group is full
+	{
+		chain_type::progress_to_next_group(total_size, 1);
+		top_index = 0;
+	}
+
+
+
+	void copy_from_source(const packed_queue &source)
+	{
+		if (source.total_size == 0) return;
+
+		const group *current = source.first_group;
+		size_type index = source.start_index;
+
+		for (size_type remaining = source.total_size; remaining != 0; --remaining, ++index)
+		{
+			if (index == current->capacity)
+			{
+				current = current->next_group;
+				index = 0;
+			}
+
+			push(static_cast<value_type>((const_cast<group *>(current)->words()[index / elements_per_word] >> ((index % elements_per_word) * bits)) & value_mask));
+		}
+	}
+
+
+
+	void destroy_all_data() PLF_NOEXCEPT
+	{
+		deallocate_all_groups();
+		blank();
+	}
+
+
+
+	void blank() PLF_NOEXCEPT
+	{
+		current_group = first_group = NULL;
+		start_index = top_index = total_size = total_capacity = 0;
+	}
+
+
+
+	// Index of the first element in [first, last) of the given group which matches the pattern, or last if none:
+	static size_type find_in_group(group * const the_group, const size_type first, const size_type last, const word_type pattern) PLF_NOEXCEPT
+	{
+		const word_type * const words = the_group->words();
+
+		for (size_type index = first; index != last;)
+		{
+			const size_type word_index = index / elements_per_word, word_start = index % elements_per_word;
+			const size_type word_end = (last - (index - word_start) < elements_per_word) ? last - (index - word_start) : elements_per_word;
+			const word_type matches = matching_elements(words[word_index], pattern) & element_range_mask(word_start, word_end);
+
+			if (matches != 0)
+			{
+				return (word_index * elements_per_word) + (plf::countr_zero(matches) / bits);
+			}
+
+			index += word_end - word_start;
+		}
+
+		return last;
+	}
+
+
+
+	static size_type count_in_group(group * const the_group, const size_type first, const size_type last, const word_type pattern) PLF_NOEXCEPT
+	{
+		const word_type * const words = the_group->words();
+		size_type total = 0;
+
+		for (size_type index = first; index != last;)
+		{
+			const size_type word_index = index / elements_per_word, word_start = index % elements_per_word;
+			const size_type word_end = (last - (index - word_start) < elements_per_word) ? last - (index - word_start) : elements_per_word;
+			total += plf::popcount(matching_elements(words[word_index], pattern) & element_range_mask(word_start, word_end));
+			index += word_end - word_start;
+		}
+
+		return total;
+	}
+
+
+
+public:
+
+	static PLF_CONSTFUNC size_type default_min_block_capacity() PLF_NOEXCEPT
+	{
+		return elements_per_word * 8;
+	}
+
+
+
+	static PLF_CONSTFUNC size_type default_max_block_capacity() PLF_NOEXCEPT
+	{
+		return elements_per_word * 384;
+	}
+
+
+
+	packed_queue() PLF_NOEXCEPT:
+		chain_type(default_min_block_capacity(), default_max_block_capacity()),
+		start_index(0),
+		top_index(0)
+	{}
+
+
+
+	// Constructor with limits, in elements:
+	packed_queue(const size_type min, const size_type max = default_max_block_capacity()):
+		chain_type(min, max),
+		start_index(0),
+		top_index(0)
+	{
+		check_capacities_conformance(min, max, 2);
+	}
+
+
+
+	packed_queue(const packed_queue &source):
+		chain_type(source.min_block_capacity, source.max_block_capacity),
+		start_index(0),
+		top_index(0)
+	{
+		copy_from_source(source);
+	}
+
+
+
+	#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+		packed_queue(packed_queue &&source) PLF_NOEXCEPT:
+			chain_type(source.min_block_capacity, source.max_block_capacity),
+			start_index(0),
+			top_index(0)
+		{
+			swap(source);
+		}
+
+
+
+		packed_queue & operator = (packed_queue &&source) PLF_NOEXCEPT
+		{
+			assert(&source != this);
+
+			destroy_all_data();
+			swap(source);
+			return *this;
+		}
+	#endif
+
+
+
+	packed_queue & operator = (const packed_queue &source)
+	{
+		assert(&source != this);
+
+		packed_queue temp(source);
+		swap(temp);
+		return *this;
+	}
+
+
+
+	~packed_queue() PLF_NOEXCEPT
+	{
+		destroy_all_data();
+	}
+
+
+
+	void push(const value_type value)
+	{
+		if (current_group == NULL)
+		{
+			initialize(0);
+		}
+		else if (top_index == current_group->capacity)
+		{
+			progress_to_next_group();
+		}
+
+		word_type &word = current_group->words()[top_index / elements_per_word];
+		const size_type shift = (top_index % elements_per_word) * bits;
+
+		if (shift == 0) // first element in the word - overwrite any previous contents
+		{
+			word = static_cast<word_type>(value) & value_mask;
+		}
+		else
+		{
+			word = (word & ~(value_mask << shift)) | ((static_cast<word_type>(value) & value_mask) << shift);
+		}
+
+		++top_index;
+		++total_size;
+	}
+
+
+
+	value_type front() const PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+		return static_cast<value_type>((first_group->words()[start_index / elements_per_word] >> ((start_index % elements_per_word) * bits)) & value_mask);
+	}
+
+
+
+	value_type back() const PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+		const size_type back_index = top_index - 1;
+		return static_cast<value_type>((current_group->words()[back_index / elements_per_word] >> ((back_index % elements_per_word) * bits)) & value_mask);
+	}
+
+
+
+	void pop() PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+
+		if (--total_size == 0)
+		{
+			start_index = top_index = 0;
+		}
+		else if (++start_index == first_group->capacity) // ie. was the last element in first_group, so first_group != current_group
+		{
+			retire_first_group();
+			start_index = 0;
+		}
+	}
+
+
+
+	// Number of elements equal to value:
+	size_type count(const value_type value) const PLF_NOEXCEPT
+	{
+		if (total_size == 0) return 0;
+
+		const word_type pattern = broadcast(value);
+		size_type total = 0;
+
+		for (group *current = first_group; ; current = current->next_group)
+		{
+			const size_type first = (current == first_group) ? start_index : 0;
+
+			if (current == current_group)
+			{
+				return total + count_in_group(current, first, top_index, pattern);
+			}
+
+			total += count_in_group(current, first, current->capacity, pattern);
+		}
+	}
+
+
+
+	// Position (from the front) of the first element equal to value, or size() if there is none:
+	size_type find(const value_type value) const PLF_NOEXCEPT
+	{
+		if (total_size == 0) return 0;
+
+		const word_type pattern = broadcast(value);
+		size_type position = 0;
+
+		for (group *current = first_group; ; current = current->next_group)
+		{
+			const size_type first = (current == first_group) ? start_index : 0;
+			const size_type last = (current == current_group) ? top_index : current->capacity;
+			const size_type found = find_in_group(current, first, last, pattern);
+
+			if (found != last)
+			{
+				return position + (found - first);
+			}
+
+			if (current == current_group)
+			{
+				return total_size;
+			}
+
+			position += last - first;
+		}
+	}
+
+
+
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() const PLF_NOEXCEPT
+	{
+		return total_size == 0;
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return total_size;
+	}
+
+
+
+	size_type max_size() const PLF_NOEXCEPT
+	{
+		return std::numeric_limits<size_type>::max() / 2;
+	}
+
+
+
+	size_type capacity() const PLF_NOEXCEPT
+	{
+		return total_capacity;
+	}
+
+
+
+	size_type memory() const PLF_NOEXCEPT
+	{
+		return sizeof(*this) + groups_memory();
+	}
+
+
+
+	void reshape(const size_type min, const size_type max)
+	{
+		check_capacities_conformance(min, max, 2);
+		min_block_capacity = min;
+		max_block_capacity = max;
+	}
+
+
+
+	void clear() PLF_NOEXCEPT
+	{
+		destroy_all_data();
+	}
+
+
+
+	// Remove trailing groups (as may be created by reserve or pop)
+	using chain_type::trim;
+
+
+
+	// Reserve capacity in elements, rounded up to a whole number of words per group:
+	using chain_type::reserve;
+
+
+
+	void swap(packed_queue &source) PLF_NOEXCEPT
+	{
+		swap_chain(source);
+		std::swap(start_index, source.start_index);
+		std::swap(top_index, source.top_index);
+	}
+}; // packed_queue
+
+
+} // plf namespace
+
+
+
+namespace std
+{
+
+template <unsigned int bits>
+void swap (plf::packed_queue<bits> &a, plf::packed_queue<bits> &b) PLF_NOEXCEPT
+{
+	a.swap(b);
+}
+
+}
+
+
+
+#ifdef PLF_PACKED_QUEUE_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_PACKED_QUEUE_H
@@ -0,0 +1,173 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+
+#include "plf_packed_queue.h"
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	unsigned int looper = 0;
+
+	while (++looper != 50)
+	{
+		{
+			title1("Test basics");
+
+			packed_queue<1> flag_queue;
+
+			failpass("Empty test", flag_queue.empty() && flag_queue.count(true) == 0);
+
+			for (unsigned int temp = 0; temp != 10000; ++temp)
+			{
+				flag_queue.push(temp % 3 == 0);
+			}
+
+			failpass("Size test", flag_queue.size() == 10000);
+			failpass("Front test", flag_queue.front() == true);
+			failpass("Back test", flag_queue.back() == (9999 % 3 == 0));
+			failpass("Memory test", flag_queue.memory() < 10000 / 4);
+			failpass("Count test", flag_queue.count(true) == 3334 && flag_queue.count(false) == 6666);
+			failpass("Find test", flag_queue.find(false) == 1 && flag_queue.find(true) == 0);
+
+			bool contents_correct = true;
+
+			for (unsigned int temp = 0; temp != 5002; ++temp)
+			{
+				if (flag_queue.front() != (temp % 3 == 0))
+				{
+					contents_correct = false;
+				}
+
+				flag_queue.pop();
+			}
+
+			failpass("Pop contents test", contents_correct && flag_queue.size() == 4998);
+			failpass("Post-pop count test", flag_queue.count(true) == 1666);
+			failpass("Post-pop find test", flag_queue.find(true) == 2);
+		}
+
+		{
+			title2("Multi-bit tests");
+
+			packed_queue<4> code_queue(16, 128);
+
+			for (unsigned int temp = 0; temp != 5000; ++temp)
+			{
+				code_queue.push(temp % 16);
+			}
+
+			for (unsigned int temp = 0; temp != 37; ++temp)
+			{
+				code_queue.pop();
+			}
+
+			failpass("Front test", code_queue.front() == 37 % 16);
+			failpass("Count test", code_queue.count(0) == 310 && code_queue.count(15) == 310);
+			failpass("Find test", code_queue.find(7) == 2 && code_queue.find(4) == 15);
+
+			packed_queue<4> code_queue2(code_queue);
+
+			failpass("Copy test", code_queue2.size() == code_queue.size() && code_queue2.count(5) == code_queue.count(5) && code_queue2.back() == 4999 % 16);
+
+			packed_queue<16> wide_queue;
+
+			for (unsigned int temp = 0; temp != 3000; ++temp)
+			{
+				wide_queue.push(temp * 7);
+			}
+
+			failpass("Wide values test", wide_queue.back() == 2999 * 7 && wide_queue.find(700) == 100 && wide_queue.find(701) == wide_queue.size());
+
+			packed_queue<32> word_queue;
+			word_queue.push(4000000000u);
+			word_queue.push(1);
+
+			failpass("32-bit values test", word_queue.front() == 4000000000u && word_queue.count(1) == 1 && word_queue.find(1) == 1);
+		}
+
+		{
+			title2("Reuse and swap tests");
+
+			packed_queue<2> pair_queue(64, 256);
+
+			for (unsigned int counter = 0; counter != 100; ++counter)
+			{
+				for (unsigned int temp = 0; temp != 300; ++temp)
+				{
+					pair_queue.push(temp % 4);
+				}
+
+				for (unsigned int temp = 0; temp != 290; ++temp)
+				{
+					pair_queue.pop();
+				}
+			}
+
+			failpass("Cycling size test", pair_queue.size() == 1000 && pair_queue.count(3) == 250);
+
+			const std::size_t capacity = pair_queue.capacity();
+
+			for (unsigned int temp = 0; temp != 50; ++temp)
+			{
+				pair_queue.push(1);
+				pair_queue.pop();
+			}
+
+			failpass("Group reuse test", pair_queue.capacity() == capacity);
+
+			packed_queue<2> pair_queue2;
+			pair_queue2.swap(pair_queue);
+
+			failpass("Swap test", pair_queue.empty() && pair_queue2.size() == 1000);
+
+			pair_queue2.clear();
+			pair_queue2.reserve(5000);
+
+			failpass("Reserve test", pair_queue2.capacity() >= 5000 && pair_queue2.empty());
+		}
+	}
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
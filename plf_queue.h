@@ -32,10 +32,16 @@
 
 #include <cstring> // memset, memcpy
 #include <cassert> // assert
+#include <cstdio> // std::FILE, std::fwrite, std::fread - used by save/load
+#include <ios> // std::streamsize - used by save/load
 #include <limits>  // std::numeric_limits
 #include <stdexcept> // std::length_error
 #include <utility> // std::move, std::swap
 
+#ifdef PLF_OPTIONAL_SUPPORT
+	#include <optional> // std::optional - used by pop_value
+#endif
+
 #ifdef PLF_TYPE_TRAITS_SUPPORT
 	#include <cstddef> // offsetof, used in blank()
 	#include <type_traits> // std::is_trivially_destructible
@@ -131,11 +137,47 @@ private:
 	group_pointer_type		current_group, first_group; // current group is location of top pointer, first_group is 'front' group, saves performance for ~queue etc
 	element_pointer_type top_element, start_element, end_element; // start_element/end_element cache current_group->end/elements for better performance
 	size_type				total_size, total_capacity, min_block_capacity;
-	struct ebco_pair : group_allocator_type // Packaging the group allocator with the least-used member variable, for empty-base-class optimization
+
+	// Decay mode's counters (see set_decay_threshold()). These are only stored when the allocator has a discard() member for decay mode to use, otherwise the empty specialization below is used and takes up no space:
+	template <bool has_discard, class dummy = void>
+	struct decay_counters
+	{
+		size_type decay_threshold, idle_transitions;
+
+		explicit decay_counters(const size_type decay) PLF_NOEXCEPT:
+			decay_threshold(decay),
+			idle_transitions(0)
+		{}
+
+		size_type threshold() const PLF_NOEXCEPT { return decay_threshold; }
+		void set_threshold(const size_type decay) PLF_NOEXCEPT { decay_threshold = decay; idle_transitions = 0; }
+		void reset_idle_transitions() PLF_NOEXCEPT { idle_transitions = 0; }
+		bool count_idle_transition() PLF_NOEXCEPT { return decay_threshold != 0 && ++idle_transitions == decay_threshold; } // true once the threshold is reached
+	};
+
+	template <class dummy>
+	struct decay_counters<false, dummy>
+	{
+		explicit decay_counters(const size_type) PLF_NOEXCEPT {}
+
+		size_type threshold() const PLF_NOEXCEPT { return 0; }
+		void set_threshold(const size_type) PLF_NOEXCEPT {}
+		void reset_idle_transitions() PLF_NOEXCEPT {}
+		bool count_idle_transition() PLF_NOEXCEPT { return false; }
+	};
+
+	#if defined(PLF_VOIDT_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+		typedef decay_counters<plf::allocator_has_discard<allocator_type>::value> decay_counters_type;
+	#else
+		typedef decay_counters<false> decay_counters_type;
+	#endif
+
+	struct ebco_pair : group_allocator_type, decay_counters_type // Packaging the group allocator with the least-used member variables, for empty-base-class optimization
 	{
 		size_type max_block_capacity;
-		ebco_pair(const size_type max_elements, const allocator_type &alloc) PLF_NOEXCEPT:
+		ebco_pair(const size_type max_elements, const allocator_type &alloc, const size_type decay = 0) PLF_NOEXCEPT:
 			group_allocator_type(alloc),
+			decay_counters_type(decay),
 			max_block_capacity(max_elements)
 		{};
 	} group_allocator_pair;
@@ -156,6 +198,26 @@ private:
 
 
 
+	// If the allocator reports the usable size of an allocation via good_size(bytes) (eg. the allocator's size class or a page multiple), round the block capacity up so that the slack at the end of the allocation is used as extra capacity rather than wasted:
+	size_type rounded_block_capacity(const size_type capacity) const PLF_NOEXCEPT
+	{
+		#if defined(PLF_VOIDT_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+			if PLF_CONSTEXPR (plf::allocator_has_good_size<allocator_type>::value)
+			{
+				if (capacity > std::numeric_limits<size_type>::max() / sizeof(element_type)) return capacity;
+
+				const size_type rounded_capacity = static_cast<size_type>(static_cast<const allocator_type &>(*this).good_size(capacity * sizeof(element_type)) / sizeof(element_type));
+				return (rounded_capacity > capacity) ? rounded_capacity : capacity;
+			}
+			else
+		#endif
+		{
+			return capacity;
+		}
+	}
+
+
+
 public:
 
 
@@ -242,8 +304,9 @@ public:
 
 private:
 
-	void allocate_new_group(const size_type capacity, const group_pointer_type previous_group)
+	void allocate_new_group(size_type capacity, const group_pointer_type previous_group)
 	{
+		capacity = rounded_block_capacity(capacity);
 		previous_group->next_group = PLF_ALLOCATE(group_allocator_type, group_allocator_pair, 1, previous_group);
 
 		#ifdef PLF_EXCEPTIONS_SUPPORT
@@ -258,6 +321,7 @@ private:
 			catch (...)
 			{
 				PLF_DEALLOCATE(group_allocator_type, group_allocator_pair, previous_group->next_group, 1);
+				previous_group->next_group = NULL; // previous_group is always the last group
 				throw;
 			}
 		#else
@@ -283,15 +347,16 @@ private:
 
 	void initialize()
 	{
+		const size_type capacity = rounded_block_capacity(min_block_capacity);
 		first_group = current_group = PLF_ALLOCATE(group_allocator_type, group_allocator_pair, 1, 0);
 
 		#ifdef PLF_EXCEPTIONS_SUPPORT
 			try
 			{
 				#ifdef PLF_VARIADICS_SUPPORT
-					PLF_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, min_block_capacity);
+					PLF_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, capacity);
 				#else
-					PLF_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, group(min_block_capacity));
+					PLF_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, group(capacity));
 				#endif
 			}
 			catch (...)
@@ -302,19 +367,179 @@ private:
 			}
 		#else
 			#ifdef PLF_VARIADICS_SUPPORT
-				PLF_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, min_block_capacity);
+				PLF_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, capacity);
 			#else
-				PLF_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, group(min_block_capacity));
+				PLF_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, group(capacity));
 			#endif
 		#endif
 
 		start_element = top_element = first_group->elements;
 		end_element = first_group->end;
-		total_capacity = min_block_capacity;
+		total_capacity = capacity;
+	}
+
+
+
+	// Release the memory pages of reserved groups (ie. groups past current_group) back to the OS, if the allocator supports it, while keeping the groups allocated:
+	void discard_reserved_groups() PLF_NOEXCEPT
+	{
+		#if defined(PLF_VOIDT_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+			if PLF_CONSTEXPR (plf::allocator_has_discard<allocator_type>::value)
+			{
+				if (current_group == NULL) return;
+
+				for (group_pointer_type current = current_group->next_group; current != NULL; current = current->next_group)
+				{
+					static_cast<allocator_type &>(*this).discard(current->elements, static_cast<size_type>(current->end - current->elements));
+				}
+			}
+		#endif
+	}
+
+
+
+	// Called whenever pop retires a front group (push only crosses a group boundary without reusing a reserved group when there are none, so is not counted). Once the threshold is reached the reserved groups are considered idle and are discarded. The counter then keeps incrementing past the threshold, so that groups are not repeatedly discarded until a reserved group is reused:
+	void count_idle_transition() PLF_NOEXCEPT
+	{
+		if (group_allocator_pair.count_idle_transition())
+		{
+			discard_reserved_groups();
+		}
 	}
 
 
 
+	// Used by pop/try_pop/pop_value once the front element has been destroyed or moved from:
+	void remove_front() PLF_NOEXCEPT
+	{
+		if (--total_size == 0)
+		{
+			start_element = first_group->elements;
+			end_element = first_group->end;
+			top_element = start_element - 1;
+		}
+		else if (++start_element == first_group->end)
+		{ // ie. is start element, but not first group in queue
+			retire_first_group();
+		}
+	}
+
+
+
+	// Used by pop/pop_while once every element in first_group has been destroyed, where first_group != current_group. The group is reused as a reserved group if it matches current_group's capacity and there are no others, otherwise deallocated:
+	void retire_first_group() PLF_NOEXCEPT
+	{
+		const group_pointer_type next_group = first_group->next_group;
+
+		if (current_group->next_group == NULL && ((first_group->end - first_group->elements) == (current_group->end - current_group->elements)))
+		{
+			current_group->next_group = first_group;
+			first_group->next_group = NULL;
+			first_group->previous_group = current_group; // keeps iterator decrement and push's exception rollback valid once the group is reused
+		}
+		else
+		{
+			total_capacity -= static_cast<size_type>(first_group->end - first_group->elements);
+			deallocate_group(first_group);
+		}
+
+		next_group->previous_group = NULL; // so that iterator decrement stops at the front group, as per rend()
+		first_group = next_group;
+		start_element = next_group->elements;
+		count_idle_transition();
+	}
+
+
+
+	void destroy_range(element_pointer_type first, const element_pointer_type last) PLF_NOEXCEPT
+	{
+		#ifdef PLF_TYPE_TRAITS_SUPPORT
+			if PLF_CONSTEXPR (!std::is_trivially_destructible<element_type>::value)
+		#endif
+		{
+			for (; first != last; ++first)
+			{
+				PLF_DESTROY(allocator_type, *this, first);
+			}
+		}
+	}
+
+
+
+	// Used by erase_if. Relocates the elements [first, last) so that they end immediately before write in queue order, decrementing write (and write_group, across group boundaries) past them. write is always at or after last in queue order, and every slot between last and write has already been destroyed or relocated from:
+	void relocate_backward(const element_pointer_type first, element_pointer_type last, group_pointer_type &write_group, element_pointer_type &write) PLF_NOEXCEPT
+	{
+		while (last != first)
+		{
+			if (write == write_group->elements)
+			{
+				write_group = write_group->previous_group;
+				write = write_group->end;
+			}
+
+			const size_type run_length = static_cast<size_type>(last - first), write_space = static_cast<size_type>(write - write_group->elements);
+			const size_type count = (run_length < write_space) ? run_length : write_space;
+			last -= count;
+			write -= count;
+
+			if (last == write) continue; // no gap yet, elements are already in place
+
+			#ifdef PLF_TYPE_TRAITS_SUPPORT
+				if PLF_CONSTEXPR (std::is_trivially_copyable<element_type>::value)
+				{
+					std::memmove(static_cast<void *>(&*write), static_cast<const void *>(&*last), count * sizeof(element_type));
+				}
+				else
+			#endif
+			{
+				for (size_type index = count; index != 0;) // back to front, as the ranges may overlap
+				{
+					--index;
+
+					#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+						PLF_CONSTRUCT_ELEMENT(write + index, std::move(*(last + index)));
+					#else
+						PLF_CONSTRUCT_ELEMENT(write + index, *(last + index));
+					#endif
+
+					PLF_DESTROY(allocator_type, *this, last + index);
+				}
+			}
+		}
+	}
+
+
+
+	struct less_than
+	{
+		template <class cutoff_type>
+		bool operator () (const element_type &element, const cutoff_type &cutoff) const
+		{
+			return element < cutoff;
+		}
+	};
+
+
+
+	template <class cutoff_type, class comparison_function>
+	struct before_cutoff
+	{
+		const cutoff_type		&cutoff;
+		comparison_function	compare;
+
+		before_cutoff(const cutoff_type &cutoff_value, const comparison_function &function):
+			cutoff(cutoff_value),
+			compare(function)
+		{}
+
+		bool operator () (const element_type &element)
+		{
+			return compare(element, cutoff);
+		}
+	};
+
+
+
 	void progress_to_next_group() // used by push/emplace
 	{
 		if (current_group->next_group == NULL) // no reserved groups or groups left over from previous pops, allocate new group
@@ -325,7 +550,24 @@ private:
 			const size_type new_group_capacity = ((divided_size < (current_group_capacity * 2)) & (divided_size > (current_group_capacity / 2))) ? current_group_capacity :
 															(divided_size < min_block_capacity) ? min_block_capacity :
 															(divided_size > group_allocator_pair.max_block_capacity) ? group_allocator_pair.max_block_capacity : divided_size;
-			allocate_new_group(new_group_capacity, current_group);
+
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				try
+				{
+					allocate_new_group(new_group_capacity, current_group);
+				}
+				catch (...)
+				{
+					--top_element; // push/emplace has already incremented top_element to end_element, so put it back on the back element
+					throw;
+				}
+			#else
+				allocate_new_group(new_group_capacity, current_group);
+			#endif
+		}
+		else // reserved group is being reused
+		{
+			group_allocator_pair.reset_idle_transitions();
 		}
 
 		current_group = current_group->next_group;
@@ -365,7 +607,6 @@ private:
 			// Handle special case of last group:
 			plf::uninitialized_copy(start_pointer, source.top_element + 1, top_element, static_cast<allocator_type &>(*this));
 			top_element += source.top_element - start_pointer; // This should make top_element == the last "pushed" element, rather than the one past it
-			end_element = top_element + 1; // Since we have created a single group where capacity == size, this is correct
 			total_size = source.total_size;
 		}
 		else // uncommon edge case, so not optimising:
@@ -396,6 +637,145 @@ private:
 
 
 
+	// Adaptors for save/load, each transferring one contiguous block of bytes per call:
+	template <class stream_type>
+	struct stream_transfer
+	{
+		stream_type &stream;
+
+		explicit stream_transfer(stream_type &target): stream(target) {}
+
+		bool write(const void * const data, const size_type bytes)
+		{
+			stream.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes));
+			return !stream.fail();
+		}
+
+		bool read(void * const data, const size_type bytes)
+		{
+			stream.read(static_cast<char *>(data), static_cast<std::streamsize>(bytes));
+			return !stream.fail();
+		}
+	};
+
+
+
+	struct file_transfer
+	{
+		std::FILE * const file;
+
+		explicit file_transfer(std::FILE * const target): file(target) {}
+
+		bool write(const void * const data, const size_type bytes)
+		{
+			return std::fwrite(data, 1, bytes, file) == bytes;
+		}
+
+		bool read(void * const data, const size_type bytes)
+		{
+			return std::fread(data, 1, bytes, file) == bytes;
+		}
+	};
+
+
+
+	// Writes the element count and size, followed by each group's segment of elements in a single write (same block structure as copy_from_source):
+	template <class transfer_type>
+	bool save_blocks(transfer_type transfer) const
+	{
+		#ifdef PLF_TYPE_TRAITS_SUPPORT
+			static_assert(std::is_trivially_copyable<element_type>::value, "save() requires a trivially copyable element type");
+		#endif
+
+		const size_type header[2] = {total_size, sizeof(element_type)};
+
+		if (!transfer.write(header, sizeof(header))) return false;
+		if (total_size == 0) return true;
+
+		group_pointer_type current_save_group = first_group;
+		element_pointer_type start_pointer = start_element;
+
+		while (current_save_group != current_group)
+		{
+			if (!transfer.write(plf::void_cast(start_pointer), static_cast<size_type>(current_save_group->end - start_pointer) * sizeof(element_type))) return false;
+
+			current_save_group = current_save_group->next_group;
+			start_pointer = current_save_group->elements;
+		}
+
+		return transfer.write(plf::void_cast(start_pointer), static_cast<size_type>((top_element + 1) - start_pointer) * sizeof(element_type));
+	}
+
+
+
+	// Replaces the contents with those written by save_blocks, reading into as few groups as the min/max block capacities allow, with one read per group:
+	template <class transfer_type>
+	bool load_blocks(transfer_type transfer)
+	{
+		#ifdef PLF_TYPE_TRAITS_SUPPORT
+			static_assert(std::is_trivially_copyable<element_type>::value, "load() requires a trivially copyable element type");
+		#endif
+
+		clear();
+
+		size_type header[2];
+
+		if (!transfer.read(header, sizeof(header)) || header[1] != sizeof(element_type) || header[0] > max_size()) return false;
+		if (header[0] == 0) return true;
+
+		size_type remaining = header[0];
+		const size_type original_min_block_capacity = min_block_capacity;
+
+		if (remaining > min_block_capacity)
+		{
+			min_block_capacity = (remaining > group_allocator_pair.max_block_capacity) ? group_allocator_pair.max_block_capacity : remaining;
+		}
+
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			try
+			{
+		#endif
+				initialize();
+				min_block_capacity = original_min_block_capacity;
+
+				while (true)
+				{
+					const size_type group_capacity = static_cast<size_type>(current_group->end - current_group->elements);
+					const size_type number_to_read = (remaining < group_capacity) ? remaining : group_capacity;
+
+					if (!transfer.read(plf::void_cast(current_group->elements), number_to_read * sizeof(element_type)))
+					{
+						total_size = 0; // elements are trivially destructible, so there is nothing to destroy
+						clear();
+						return false;
+					}
+
+					top_element = current_group->elements + (number_to_read - 1);
+					total_size += number_to_read;
+					remaining -= number_to_read;
+
+					if (remaining == 0) break;
+
+					allocate_new_group((remaining > group_allocator_pair.max_block_capacity) ? group_allocator_pair.max_block_capacity : (remaining < min_block_capacity) ? min_block_capacity : remaining, current_group);
+					current_group = current_group->next_group;
+					end_element = current_group->end; // kept in step with current_group, so that the queue is consistent if a later allocation or read fails
+				}
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			}
+			catch (...) // group allocation failed - as per a failed read, leave the queue empty and return false
+			{
+				min_block_capacity = original_min_block_capacity;
+				total_size = 0;
+				clear();
+				return false;
+			}
+		#endif
+
+		return true;
+	}
+
+
+
 	void destroy_all_data() PLF_NOEXCEPT
 	{
 		#ifdef PLF_TYPE_TRAITS_SUPPORT
@@ -483,7 +863,7 @@ public:
 		total_size(0),
 		total_capacity(0),
 		min_block_capacity(source.min_block_capacity),
-		group_allocator_pair(source.group_allocator_pair.max_block_capacity, *this)
+		group_allocator_pair(source.group_allocator_pair.max_block_capacity, *this, source.group_allocator_pair.threshold())
 	{
 		copy_from_source(source);
 	}
@@ -501,7 +881,7 @@ public:
 		total_size(0),
 		total_capacity(0),
 		min_block_capacity(source.min_block_capacity),
-		group_allocator_pair(source.group_allocator_pair.max_block_capacity, alloc)
+		group_allocator_pair(source.group_allocator_pair.max_block_capacity, alloc, source.group_allocator_pair.threshold())
 	{
 		copy_from_source(source);
 	}
@@ -520,7 +900,7 @@ public:
 			total_size(source.total_size),
 			total_capacity(source.total_capacity),
 			min_block_capacity(source.min_block_capacity),
-			group_allocator_pair(source.group_allocator_pair.max_block_capacity, source)
+			group_allocator_pair(source.group_allocator_pair.max_block_capacity, source, source.group_allocator_pair.threshold())
 		{
 			source.blank();
 		}
@@ -538,7 +918,7 @@ public:
 			total_size(source.total_size),
 			total_capacity(source.total_capacity),
 			min_block_capacity(source.min_block_capacity),
-			group_allocator_pair(source.group_allocator_pair.max_block_capacity, alloc)
+			group_allocator_pair(source.group_allocator_pair.max_block_capacity, alloc, source.group_allocator_pair.threshold())
 		{
 			#ifdef PLF_IS_ALWAYS_EQUAL_SUPPORT
 				if PLF_CONSTEXPR (!std::allocator_traits<allocator_type>::is_always_equal::value)
@@ -750,30 +1130,200 @@ public:
 			PLF_DESTROY(allocator_type, *this, start_element);
 		}
 
-		if (--total_size == 0)
+		remove_front();
+	}
+
+
+
+	// Moves the front element into destination and pops it in one step, or returns false if the queue is empty. Trivially copyable elements are memcpy'd, with no destructor call:
+	bool try_pop(element_type &destination)
+	{
+		if (total_size == 0) return false;
+
+		#ifdef PLF_TYPE_TRAITS_SUPPORT
+			if PLF_CONSTEXPR (std::is_trivially_copyable<element_type>::value)
+			{
+				std::memcpy(static_cast<void *>(&destination), static_cast<const void *>(&*start_element), sizeof(element_type));
+			}
+			else
+		#endif
+		{
+			#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+				destination = std::move(*start_element);
+			#else
+				destination = *start_element;
+			#endif
+
+			#ifdef PLF_TYPE_TRAITS_SUPPORT
+				if PLF_CONSTEXPR (!std::is_trivially_destructible<element_type>::value)
+			#endif
+			{
+				PLF_DESTROY(allocator_type, *this, start_element);
+			}
+		}
+
+		remove_front();
+		return true;
+	}
+
+
+
+	#ifdef PLF_OPTIONAL_SUPPORT
+		// Returns the front element moved into a std::optional and pops it, or an empty optional if the queue is empty:
+		#ifdef PLF_CPP20_SUPPORT
+			[[nodiscard]]
+		#endif
+		std::optional<element_type> pop_value()
+		{
+			if (total_size == 0) return std::nullopt;
+
+			std::optional<element_type> result(std::move(*start_element));
+
+			#ifdef PLF_TYPE_TRAITS_SUPPORT
+				if PLF_CONSTEXPR (!std::is_trivially_destructible<element_type>::value)
+			#endif
+			{
+				PLF_DESTROY(allocator_type, *this, start_element);
+			}
+
+			remove_front();
+			return result;
+		}
+	#endif
+
+
+
+	// Pops elements from the front for as long as predicate(element) is true, eg. entries older than a cutoff in a queue pushed in time order. The elements must be partitioned with respect to the predicate, ie. once it returns false for one element it must return false for all elements after it.
+	// Rather than testing every element, the last element of each group is tested: groups whose last element satisfies the predicate are destroyed and retired whole, as per pop(), and the cutoff within the first group that doesn't is found by binary search - O(groups + log(block capacity)) predicate calls. Returns the number of elements popped:
+	template <class predicate_type>
+	size_type pop_while(predicate_type predicate)
+	{
+		if (total_size == 0) return 0;
+
+		const size_type original_size = total_size;
+
+		while (first_group != current_group && predicate(*(first_group->end - 1)))
+		{
+			destroy_range(start_element, first_group->end);
+			total_size -= static_cast<size_type>(first_group->end - start_element);
+			retire_first_group();
+		}
+
+		// Binary search for the first element which doesn't satisfy the predicate, within the remainder of first_group:
+		element_pointer_type cutoff = start_element;
+		size_type length = static_cast<size_type>(((first_group == current_group) ? top_element + 1 : first_group->end) - start_element);
+
+		while (length != 0)
+		{
+			const size_type half = length / 2;
+
+			if (predicate(*(cutoff + half)))
+			{
+				cutoff += half + 1;
+				length -= half + 1;
+			}
+			else
+			{
+				length = half;
+			}
+		}
+
+		destroy_range(start_element, cutoff);
+		total_size -= static_cast<size_type>(cutoff - start_element);
+
+		if (total_size == 0) // as per pop()
 		{
 			start_element = first_group->elements;
 			end_element = first_group->end;
 			top_element = start_element - 1;
 		}
-		else if (++start_element == first_group->end)
-		{ // ie. is start element, but not first group in queue
-			const group_pointer_type next_group = first_group->next_group;
+		else
+		{
+			start_element = cutoff;
+		}
+
+		return original_size - total_size;
+	}
+
+
+
+	// Pops elements which compare less than cutoff, ie. pop_while(element < cutoff). Elements must be in non-descending order, at least with respect to cutoff:
+	template <class cutoff_type>
+	size_type pop_while_before(const cutoff_type &cutoff)
+	{
+		return pop_while(before_cutoff<cutoff_type, less_than>(cutoff, less_than()));
+	}
+
+
+
+	// As above, but popping while compare(element, cutoff) is true:
+	template <class cutoff_type, class comparison_function>
+	size_type pop_while_before(const cutoff_type &cutoff, comparison_function compare)
+	{
+		return pop_while(before_cutoff<cutoff_type, comparison_function>(cutoff, compare));
+	}
+
+
+
+	// Erases every element for which predicate(element) is true, preserving the order of the remainder. This is done in a single back-to-front pass without allocation: surviving elements are compacted toward the back of the queue in runs (memmove'd for trivially copyable types), so the front moves forward and any groups emptied at the front are retired as per pop(). predicate must not throw, and element_type must be nothrow move-constructible (or trivially copyable), as a throw part-way through compaction cannot be undone - in C++03 this means the copy constructor must not throw. Returns the number of elements erased:
+	template <class predicate_type>
+	size_type erase_if(predicate_type predicate)
+	{
+		#ifdef PLF_TYPE_TRAITS_SUPPORT
+			static_assert(std::is_trivially_copyable<element_type>::value || std::is_nothrow_move_constructible<element_type>::value, "erase_if() requires a nothrow move-constructible element type");
+		#endif
+
+		if (total_size == 0) return 0;
+
+		const size_type original_size = total_size;
+		group_pointer_type read_group = current_group, write_group = current_group;
+		element_pointer_type read = top_element + 1, write = top_element + 1; // write is the front of the compacted elements, read is one-past the next element to test
 
-			if (current_group->next_group == NULL && ((first_group->end - first_group->elements) == (current_group->end - current_group->elements)))
+		while (true)
+		{
+			const element_pointer_type group_begin = (read_group == first_group) ? start_element : read_group->elements;
+			element_pointer_type run_end = read; // one-past the current run of surviving elements
+
+			while (read != group_begin)
 			{
-				current_group->next_group = first_group;
-				first_group->next_group = NULL;
+				if (predicate(*--read))
+				{
+					relocate_backward(read + 1, run_end, write_group, write);
+					PLF_DESTROY(allocator_type, *this, read);
+					run_end = read;
+					--total_size;
+				}
 			}
-			else
+
+			relocate_backward(read, run_end, write_group, write);
+
+			if (read_group == first_group) break;
+
+			read_group = read_group->previous_group;
+			read = read_group->end;
+		}
+
+		if (total_size == 0)
+		{
+			while (first_group != current_group)
 			{
-				total_capacity -= static_cast<size_type>(first_group->end - first_group->elements);
-				deallocate_group(first_group);
+				retire_first_group();
 			}
 
-			first_group = next_group;
-			start_element = next_group->elements;
+			start_element = first_group->elements; // as per pop()
+			top_element = start_element - 1;
+		}
+		else
+		{
+			while (first_group != write_group)
+			{
+				retire_first_group();
+			}
+
+			start_element = write;
 		}
+
+		return original_size - total_size;
 	}
 
 
@@ -819,6 +1369,7 @@ public:
 				total_capacity = source.total_capacity;
 				min_block_capacity = source.min_block_capacity;
 				group_allocator_pair.max_block_capacity = source.group_allocator_pair.max_block_capacity;
+				static_cast<decay_counters_type &>(group_allocator_pair) = source.group_allocator_pair;
 
 				#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
 					if PLF_CONSTEXPR (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value)
@@ -948,7 +1499,6 @@ private:
 				// Handle special case of last group:
 				plf::uninitialized_copy(start_pointer, source.top_element + 1, top_element, static_cast<allocator_type &>(*this));
 				top_element += source.top_element - start_pointer; // This should make top_element == the last "pushed" element, rather than the one past it
-				end_element = top_element + 1; // Since we have created a single group where capacity == size, this is correct
 				total_size = source.total_size;
 			}
 			else // uncommon edge case, so not optimising:
@@ -997,6 +1547,7 @@ private:
 			}
 
 			temp.min_block_capacity = min_block_capacity; // reset to correct value for future clear() or erasures
+			temp.group_allocator_pair.set_threshold(group_allocator_pair.threshold());
 			*this = std::move(temp);
 		#else
 			queue temp(*this);
@@ -1018,7 +1569,7 @@ public:
 
 		for (group_pointer_type current = first_group; current != NULL; current = current->next_group)
 		{
-			if (static_cast<size_type>(current->end - current->elements) < min || static_cast<size_type>(current->end - current->elements) > max)
+			if (static_cast<size_type>(current->end - current->elements) < min || static_cast<size_type>(current->end - current->elements) > rounded_block_capacity(max))
 			{
 				#ifdef PLF_TYPE_TRAITS_SUPPORT // If type is non-copyable/movable, cannot be consolidated, throw exception:
 					if PLF_CONSTEXPR (!((std::is_copy_constructible<element_type>::value && std::is_copy_assignable<element_type>::value) || (std::is_move_constructible<element_type>::value && std::is_move_assignable<element_type>::value)))
@@ -1090,6 +1641,29 @@ public:
 
 
 
+	// Release the memory pages of reserved groups (as may be created by reserve or pop) back to the OS without deallocating the groups, so that reusing them later only costs page faults rather than new allocations. Requires an allocator with a discard(pointer, size) member function (eg. plf::size_class_allocator), otherwise does nothing. Can be called from a timer for time-based decay:
+	void decay() PLF_NOEXCEPT
+	{
+		discard_reserved_groups();
+	}
+
+
+
+	// Decay mode: when non-zero, reserved groups are discarded as per decay() once pop has retired this many front groups without push reusing a reserved group in between. Zero (the default) disables decay mode. As per decay(), this requires an allocator with a discard(pointer, size) member function - otherwise the threshold is not stored and decay_threshold() returns zero:
+	void set_decay_threshold(const size_type block_transitions) PLF_NOEXCEPT
+	{
+		group_allocator_pair.set_threshold(block_transitions);
+	}
+
+
+
+	size_type decay_threshold() const PLF_NOEXCEPT
+	{
+		return group_allocator_pair.threshold();
+	}
+
+
+
 	void shrink_to_fit()
 	{
 		if (first_group == NULL || total_size == capacity())
@@ -1175,9 +1749,65 @@ public:
 
 
 
+	// Calls function(block_begin, block_end, number_of_elements_in_block) for every allocated block in the queue, front to back, including reserved blocks. Block pointers are const_pointer's. Intended for statistics eg. block placement or utilization. As per std::for_each, returns the function object:
+	template <class function_type>
+	function_type for_each_block(function_type function) const
+	{
+		bool past_back = (total_size == 0); // ie. all blocks are empty
+
+		for (group_pointer_type current = first_group; current != NULL; current = current->next_group)
+		{
+			size_type number_of_elements = 0;
+
+			if (!past_back)
+			{
+				number_of_elements = static_cast<size_type>(((current == current_group) ? top_element + 1 : current->end) - ((current == first_group) ? start_element : current->elements));
+				past_back = (current == current_group); // Groups after current_group are reserved
+			}
+
+			function(static_cast<const_pointer>(current->elements), static_cast<const_pointer>(current->end), number_of_elements);
+		}
+
+		return function;
+	}
+
+
+
+	// Binary snapshot of the queue for trivially copyable types, written as the element count and size followed by each contiguous group segment in a single write() call. stream_type must support write(const char *, std::streamsize) and fail(), as std::ostream does. Returns false on failure:
+	template <class stream_type>
+	bool save(stream_type &stream) const
+	{
+		return save_blocks(stream_transfer<stream_type>(stream));
+	}
+
+
+
+	bool save(std::FILE * const file) const
+	{
+		return save_blocks(file_transfer(file));
+	}
+
+
+
+	// Replaces the queue's contents with a snapshot written by save(), reading directly into a newly-allocated group chain with one read() call per group. Returns false and leaves the queue empty on failure (including allocation failure), or if the snapshot was written with a different element size:
+	template <class stream_type>
+	bool load(stream_type &stream)
+	{
+		return load_blocks(stream_transfer<stream_type>(stream));
+	}
+
+
+
+	bool load(std::FILE * const file)
+	{
+		return load_blocks(file_transfer(file));
+	}
+
+
+
 	allocator_type get_allocator() const PLF_NOEXCEPT
 	{
-		return allocator_type();
+		return static_cast<const allocator_type &>(*this);
 	}
 
 
@@ -1207,6 +1837,7 @@ public:
 			const group_pointer_type	swap_current_group = current_group, swap_first_group = first_group;
 			const element_pointer_type swap_top_element = top_element, swap_start_element = start_element, swap_end_element = end_element;
 			const size_type				swap_total_size = total_size, swap_total_capacity = total_capacity, swap_min_block_capacity = min_block_capacity, swap_max_block_capacity = group_allocator_pair.max_block_capacity;
+			const decay_counters_type	swap_decay_counters = group_allocator_pair;
 
 			current_group = source.current_group;
 			first_group = source.first_group;
@@ -1217,6 +1848,7 @@ public:
 			total_capacity = source.total_capacity;
 			min_block_capacity = source.min_block_capacity;
 			group_allocator_pair.max_block_capacity = source.group_allocator_pair.max_block_capacity;
+			static_cast<decay_counters_type &>(group_allocator_pair) = source.group_allocator_pair;
 
 			source.current_group = swap_current_group;
 			source.first_group = swap_first_group;
@@ -1227,6 +1859,7 @@ public:
 			source.total_capacity = swap_total_capacity;
 			source.min_block_capacity = swap_min_block_capacity;
 			source.group_allocator_pair.max_block_capacity = swap_max_block_capacity;
+			static_cast<decay_counters_type &>(source.group_allocator_pair) = swap_decay_counters;
 
 			#ifdef PLF_IS_ALWAYS_EQUAL_SUPPORT
 				if PLF_CONSTEXPR (std::allocator_traits<allocator_type>::propagate_on_container_swap::value && !std::allocator_traits<allocator_type>::is_always_equal::value)
@@ -1274,9 +1907,10 @@ public:
 
 
 
+	// If the back element fills current_group and reserved groups follow it, incrementing an iterator past the back element moves it to the start of the next group, so end() must match that:
 	iterator end() PLF_NOEXCEPT
 	{
-		return iterator(current_group, top_element + (1 * (top_element != NULL)));
+		return (top_element != NULL && top_element + 1 == end_element && current_group->next_group != NULL) ? iterator(current_group->next_group, current_group->next_group->elements) : iterator(current_group, top_element + (1 * (top_element != NULL)));
 	}
 
 
@@ -1297,7 +1931,7 @@ public:
 
 	const_iterator cend() const PLF_NOEXCEPT
 	{
-		return const_iterator(current_group, top_element + (1 * (top_element != NULL)));
+		return (top_element != NULL && top_element + 1 == end_element && current_group->next_group != NULL) ? const_iterator(current_group->next_group, current_group->next_group->elements) : const_iterator(current_group, top_element + (1 * (top_element != NULL)));
 	}
 
 
@@ -0,0 +1,588 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+// Allocators which act as block policies for plf::queue. plf::queue will query an allocator's good_size(bytes) member function, if present, to find the usable size of each element block allocation, and use any slack as extra capacity.
+// If the allocator has a discard(pointer, size) member function, plf::queue's decay() and decay mode will use it to release the memory pages of idle reserved blocks back to the OS.
+
+
+#ifndef PLF_QUEUE_ALLOCATORS_H
+#define PLF_QUEUE_ALLOCATORS_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_QUEUE_ALLOCATORS_DEFINES
+#endif
+
+#include "plf_tools.h"
+
+
+#include <cstddef> // std::size_t
+#include <memory> // std::allocator
+#include <new> // std::bad_alloc, operator new
+
+#ifdef PLF_VARIADICS_SUPPORT
+	#include <utility> // std::forward, std::move
+#endif
+
+#if defined(__linux__)
+	#include <sys/mman.h> // mmap, munmap, madvise
+	#include <sys/syscall.h> // SYS_mbind, SYS_get_mempolicy, SYS_getcpu
+	#include <unistd.h> // sysconf, syscall
+#endif
+
+
+
+namespace plf
+{
+
+
+// Rounds a requested allocation size in bytes up to the size class it would be served from by a jemalloc-style allocator (4 classes per power of two, 16-byte spacing below 128 bytes). Above 16KB these classes are all page multiples, which also matches glibc's behaviour for mmap'd allocations:
+inline PLF_CONSTFUNC std::size_t allocation_size_class(const std::size_t bytes) PLF_NOEXCEPT
+{
+	if (bytes <= 128) return (bytes + 15) & ~static_cast<std::size_t>(15);
+
+	std::size_t spacing = 32; // ie. 128 to 256 bytes
+
+	while ((spacing << 3) <= bytes - 1 && (spacing << 3) > spacing) // ie. spacing == (highest power of two below bytes) / 4 (second condition is for overflow)
+	{
+		spacing <<= 1;
+	}
+
+	const std::size_t rounded = (bytes + (spacing - 1)) & ~(spacing - 1);
+	return (rounded < bytes) ? bytes : rounded; // overflow check
+}
+
+
+
+#if defined(__linux__)
+	inline std::size_t system_page_size() PLF_NOEXCEPT
+	{
+		static const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+		return page_size;
+	}
+#endif
+
+
+
+// Releases the physical pages which lie entirely within the given memory range back to the OS, while keeping the address range valid. The next access to those pages will fault in zero-filled pages. Only the pages fully inside the range are released, so this is safe to use on allocations from a general-purpose heap. Does nothing on non-Linux platforms:
+inline void discard_pages(void * const location, const std::size_t bytes) PLF_NOEXCEPT
+{
+	#if defined(__linux__)
+		const std::size_t page_size = system_page_size();
+		const std::size_t first_page = (reinterpret_cast<std::size_t>(location) + (page_size - 1)) & ~(page_size - 1),
+								end_page = (reinterpret_cast<std::size_t>(location) + bytes) & ~(page_size - 1);
+
+		if (end_page > first_page)
+		{
+			madvise(reinterpret_cast<void *>(first_page), end_page - first_page, MADV_DONTNEED); // Advisory - on failure the pages simply stay resident
+		}
+	#else
+		static_cast<void>(location);
+		static_cast<void>(bytes);
+	#endif
+}
+
+
+
+// std::allocator with a good_size() member, so that plf::queue will size it's element blocks to fill allocator size classes, and a discard() member for plf::queue's decay mode:
+template <class element_type>
+class size_class_allocator : public std::allocator<element_type>
+{
+public:
+	typedef element_type	value_type;
+	typedef std::size_t		size_type;
+
+	template <class other_type> struct rebind { typedef size_class_allocator<other_type> other; };
+
+
+	size_class_allocator() PLF_NOEXCEPT
+	{}
+
+
+	size_class_allocator(const size_class_allocator &source) PLF_NOEXCEPT:
+		std::allocator<element_type>(source)
+	{}
+
+
+	template <class other_type>
+	size_class_allocator(const size_class_allocator<other_type> &) PLF_NOEXCEPT
+	{}
+
+
+	size_type good_size(const size_type bytes) const PLF_NOEXCEPT
+	{
+		return plf::allocation_size_class(bytes);
+	}
+
+
+
+	void discard(element_type * const location, const size_type size) PLF_NOEXCEPT
+	{
+		plf::discard_pages(static_cast<void *>(location), size * sizeof(element_type));
+	}
+};
+
+
+
+
+
+// Allocates blocks of huge_page_size bytes or more directly from the OS via mmap, aligned to and rounded up to multiples of huge_page_size, and asks the kernel to back them with transparent huge pages (or, if explicit_huge_pages is true, tries hugetlbfs pages via MAP_HUGETLB first). This reduces TLB misses when iterating or popping through very large queues.
+// Smaller allocations (including plf::queue's group headers) are passed to std::allocator. good_size() rounds large requests up to huge page multiples, so plf::queue will use the full mapping as capacity. Use huge_block_capacity() as the queue's max block capacity (and, for very large queues, min block capacity) so that blocks are large enough to be mapped.
+// On non-Linux platforms this falls back to std::allocator for all allocations.
+template <class element_type, std::size_t huge_page_size = 2097152, bool explicit_huge_pages = false>
+class huge_page_allocator : public std::allocator<element_type>
+{
+public:
+	typedef element_type	value_type;
+	typedef element_type *	pointer;
+	typedef std::size_t		size_type;
+
+	template <class other_type> struct rebind { typedef huge_page_allocator<other_type, huge_page_size, explicit_huge_pages> other; };
+
+
+	huge_page_allocator() PLF_NOEXCEPT
+	{}
+
+
+	huge_page_allocator(const huge_page_allocator &source) PLF_NOEXCEPT:
+		std::allocator<element_type>(source)
+	{}
+
+
+	template <class other_type>
+	huge_page_allocator(const huge_page_allocator<other_type, huge_page_size, explicit_huge_pages> &) PLF_NOEXCEPT
+	{}
+
+
+
+	static PLF_CONSTFUNC size_type huge_block_capacity() PLF_NOEXCEPT
+	{
+		return (huge_page_size / sizeof(element_type) < 2) ? 2 : huge_page_size / sizeof(element_type);
+	}
+
+
+
+	size_type good_size(const size_type bytes) const PLF_NOEXCEPT
+	{
+		return (bytes >= huge_page_size) ? round_to_huge_pages(bytes) : plf::allocation_size_class(bytes);
+	}
+
+
+
+	pointer allocate(const size_type size, const void * = 0)
+	{
+		#if defined(__linux__)
+			if (size >= huge_block_capacity() && size <= (static_cast<size_type>(-1) - huge_page_size) / sizeof(element_type))
+			{
+				return static_cast<pointer>(map(round_to_huge_pages(size * sizeof(element_type))));
+			}
+		#endif
+
+		return std::allocator<element_type>::allocate(size);
+	}
+
+
+
+	void deallocate(const pointer location, const size_type size) PLF_NOEXCEPT
+	{
+		#if defined(__linux__)
+			if (size >= huge_block_capacity() && size <= (static_cast<size_type>(-1) - huge_page_size) / sizeof(element_type))
+			{
+				munmap(static_cast<void *>(location), round_to_huge_pages(size * sizeof(element_type)));
+				return;
+			}
+		#endif
+
+		std::allocator<element_type>::deallocate(location, size);
+	}
+
+
+
+	void discard(const pointer location, const size_type size) PLF_NOEXCEPT
+	{
+		plf::discard_pages(static_cast<void *>(location), size * sizeof(element_type));
+	}
+
+
+
+private:
+
+	static PLF_CONSTFUNC size_type round_to_huge_pages(const size_type bytes) PLF_NOEXCEPT
+	{
+		return (bytes + (huge_page_size - 1)) & ~(huge_page_size - 1);
+	}
+
+
+
+	#if defined(__linux__)
+		static void * map(const size_type bytes)
+		{
+			#ifdef MAP_HUGETLB
+				if PLF_CONSTEXPR (explicit_huge_pages)
+				{
+					void * const location = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+					if (location != MAP_FAILED) return location;
+					// else no hugetlbfs pages reserved, fall back to transparent huge pages
+				}
+			#endif
+
+			// Over-map by one huge page so that the returned range can be aligned to a huge page boundary, which is necessary for the kernel to use huge pages for the whole range, then unmap the unaligned head and tail:
+			char * const mapping = static_cast<char *>(mmap(NULL, bytes + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+
+			if (static_cast<void *>(mapping) == MAP_FAILED)
+			{
+				#ifdef PLF_EXCEPTIONS_SUPPORT
+					throw std::bad_alloc();
+				#else
+					std::terminate();
+				#endif
+			}
+
+			char * const location = reinterpret_cast<char *>((reinterpret_cast<std::size_t>(mapping) + (huge_page_size - 1)) & ~(huge_page_size - 1));
+			const size_type head = static_cast<size_type>(location - mapping), tail = huge_page_size - head;
+
+			if (head != 0) munmap(mapping, head);
+			if (tail != 0) munmap(location + bytes, tail);
+
+			#ifdef MADV_HUGEPAGE
+				madvise(location, bytes, MADV_HUGEPAGE); // Advisory only - failure (eg. THP disabled) just means normal pages are used
+			#endif
+
+			return location;
+		}
+	#endif
+};
+
+
+
+
+
+// Allocates every block aligned to the larger of alignment (default: a 64-byte cache line) and alignof(element_type), so that loops processing a queue's blocks can assume aligned block starts eg. for SIMD, and blocks do not share cache lines with other allocations. This also supports over-aligned element types in pre-C++17 modes, where std::allocator does not. alignment must be a power of two.
+// good_size() rounds block sizes up to both the allocator size class and a multiple of the alignment, so that block ends are also aligned.
+template <class element_type, std::size_t alignment = 64>
+class aligned_allocator : public std::allocator<element_type>
+{
+public:
+	typedef element_type	value_type;
+	typedef element_type *	pointer;
+	typedef std::size_t		size_type;
+
+	template <class other_type> struct rebind { typedef aligned_allocator<other_type, alignment> other; };
+
+
+	aligned_allocator() PLF_NOEXCEPT
+	{}
+
+
+	aligned_allocator(const aligned_allocator &source) PLF_NOEXCEPT:
+		std::allocator<element_type>(source)
+	{}
+
+
+	template <class other_type>
+	aligned_allocator(const aligned_allocator<other_type, alignment> &) PLF_NOEXCEPT
+	{}
+
+
+
+	static PLF_CONSTFUNC size_type block_alignment() PLF_NOEXCEPT
+	{
+		#ifdef PLF_ALIGNMENT_SUPPORT
+			return (alignof(element_type) > alignment) ? alignof(element_type) : ((alignment < sizeof(void *)) ? sizeof(void *) : alignment);
+		#else
+			return (alignment < sizeof(void *)) ? sizeof(void *) : alignment;
+		#endif
+	}
+
+
+
+	size_type good_size(const size_type bytes) const PLF_NOEXCEPT
+	{
+		const size_type size_class = plf::allocation_size_class(bytes), rounded = (size_class + (block_alignment() - 1)) & ~(block_alignment() - 1);
+		return (rounded < size_class) ? size_class : rounded;
+	}
+
+
+
+	pointer allocate(const size_type size, const void * = 0)
+	{
+		if (size > (static_cast<size_type>(-1) - (block_alignment() * 2)) / sizeof(element_type))
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::bad_alloc();
+			#else
+				std::terminate();
+			#endif
+		}
+
+		#ifdef __cpp_aligned_new
+			return static_cast<pointer>(::operator new(size * sizeof(element_type), static_cast<std::align_val_t>(block_alignment())));
+		#else // Over-allocate and store the original allocation's address immediately before the aligned block:
+			char * const allocation = static_cast<char *>(::operator new((size * sizeof(element_type)) + block_alignment()));
+			char * const location = reinterpret_cast<char *>((reinterpret_cast<std::size_t>(allocation) + block_alignment()) & ~(block_alignment() - 1));
+			*(reinterpret_cast<void **>(location) - 1) = static_cast<void *>(allocation);
+			return reinterpret_cast<pointer>(location);
+		#endif
+	}
+
+
+
+	void deallocate(const pointer location, const size_type) PLF_NOEXCEPT
+	{
+		#ifdef __cpp_aligned_new
+			::operator delete(static_cast<void *>(location), static_cast<std::align_val_t>(block_alignment()));
+		#else
+			::operator delete(*(reinterpret_cast<void **>(location) - 1));
+		#endif
+	}
+
+
+
+	void discard(const pointer location, const size_type size) PLF_NOEXCEPT
+	{
+		plf::discard_pages(static_cast<void *>(location), size * sizeof(element_type));
+	}
+};
+
+
+
+#if defined(PLF_ALIGNMENT_SUPPORT) && defined(PLF_VARIADICS_SUPPORT)
+	// Element wrapper which pads (and aligns) each element to it's own cache line, so that a producer writing to the back of a queue and a consumer reading from the front do not falsely share a cache line when the queue is small. Use with plf::aligned_allocator, or an allocator which respects alignof, eg. C++17 std::allocator:
+	template <class element_type, std::size_t alignment = 64>
+	struct alignas(alignment) padded_element
+	{
+		element_type value;
+
+		padded_element():
+			value()
+		{}
+
+		padded_element(const element_type &element):
+			value(element)
+		{}
+
+		padded_element(element_type &&element):
+			value(std::move(element))
+		{}
+
+		template<typename argument1, typename argument2, typename... arguments> // Two or more arguments, so as not to hijack the copy/move constructors
+		padded_element(argument1 &&parameter1, argument2 &&parameter2, arguments &&... parameters):
+			value(std::forward<argument1>(parameter1), std::forward<argument2>(parameter2), std::forward<arguments>(parameters)...)
+		{}
+
+		operator element_type & () PLF_NOEXCEPT
+		{
+			return value;
+		}
+
+		operator const element_type & () const PLF_NOEXCEPT
+		{
+			return value;
+		}
+	};
+#endif
+
+
+
+// NUMA tools. These use the kernel's memory policy system calls directly rather than libnuma, so no additional library is required. On non-Linux platforms they report node -1 and do nothing:
+
+// Returns the NUMA node of the CPU the calling thread is currently running on, or -1 if unknown. Construct a plf::numa_allocator with this on the consumer's thread in order to place a queue's blocks on the consumer's node:
+inline int current_numa_node() PLF_NOEXCEPT
+{
+	#if defined(__linux__) && defined(SYS_getcpu)
+		unsigned int cpu = 0, node = 0;
+		return (syscall(SYS_getcpu, &cpu, &node, NULL) == 0) ? static_cast<int>(node) : -1;
+	#else
+		return -1;
+	#endif
+}
+
+
+
+// Returns the NUMA node which the memory page containing location is resident on, or -1 if unknown. For use with plf::queue::for_each_block() to report the placement of each block:
+inline int numa_node_of(const void * const location) PLF_NOEXCEPT
+{
+	#if defined(__linux__) && defined(SYS_get_mempolicy)
+		int node = -1;
+		const unsigned long node_flag = 1, address_flag = 2; // MPOL_F_NODE, MPOL_F_ADDR
+		return (syscall(SYS_get_mempolicy, &node, NULL, 0UL, location, node_flag | address_flag) == 0) ? node : -1;
+	#else
+		static_cast<void>(location);
+		return -1;
+	#endif
+}
+
+
+
+// Allocates element blocks of one page or more with mmap and binds them to a chosen NUMA node (preferred policy, so allocation falls back to other nodes rather than failing if the node is out of memory). Smaller allocations, including plf::queue's group headers, are passed to std::allocator.
+// A node of -1 (the default) applies no binding ie. the kernel's default first-touch placement. good_size() rounds page-sized-or-larger requests up to page multiples, so that plf::queue uses the whole mapping.
+template <class element_type>
+class numa_allocator : public std::allocator<element_type>
+{
+public:
+	typedef element_type	value_type;
+	typedef element_type *	pointer;
+	typedef std::size_t		size_type;
+
+	#ifdef PLF_IS_ALWAYS_EQUAL_SUPPORT
+		typedef std::false_type is_always_equal;
+	#endif
+
+	template <class other_type> struct rebind { typedef numa_allocator<other_type> other; };
+
+	int node;
+
+
+	explicit numa_allocator(const int numa_node = -1) PLF_NOEXCEPT:
+		node(numa_node)
+	{}
+
+
+	numa_allocator(const numa_allocator &source) PLF_NOEXCEPT:
+		std::allocator<element_type>(source),
+		node(source.node)
+	{}
+
+
+	template <class other_type>
+	numa_allocator(const numa_allocator<other_type> &source) PLF_NOEXCEPT:
+		node(source.node)
+	{}
+
+
+	numa_allocator & operator = (const numa_allocator &source) PLF_NOEXCEPT
+	{
+		node = source.node;
+		return *this;
+	}
+
+
+
+	size_type good_size(const size_type bytes) const PLF_NOEXCEPT
+	{
+		#if defined(__linux__)
+			const size_type page_size = system_page_size();
+			return (bytes >= page_size && bytes <= static_cast<size_type>(-1) - page_size) ? (bytes + (page_size - 1)) & ~(page_size - 1) : plf::allocation_size_class(bytes);
+		#else
+			return plf::allocation_size_class(bytes);
+		#endif
+	}
+
+
+
+	pointer allocate(const size_type size, const void * = 0)
+	{
+		#if defined(__linux__)
+			if (is_mapped(size))
+			{
+				const size_type bytes = mapped_size(size);
+				void * const location = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+				if (location == MAP_FAILED)
+				{
+					#ifdef PLF_EXCEPTIONS_SUPPORT
+						throw std::bad_alloc();
+					#else
+						std::terminate();
+					#endif
+				}
+
+				#ifdef SYS_mbind
+					if (node >= 0 && node < static_cast<int>(sizeof(unsigned long) * 8 * 4))
+					{
+						unsigned long node_mask[4] = {0, 0, 0, 0};
+						node_mask[node / (sizeof(unsigned long) * 8)] = 1UL << (node % (sizeof(unsigned long) * 8));
+						const unsigned long preferred_mode = 1; // MPOL_PREFERRED
+						syscall(SYS_mbind, location, bytes, preferred_mode, node_mask, static_cast<unsigned long>(sizeof(node_mask) * 8), 0UL); // Advisory - on failure default placement is used
+					}
+				#endif
+
+				return static_cast<pointer>(location);
+			}
+		#endif
+
+		return std::allocator<element_type>::allocate(size);
+	}
+
+
+
+	void deallocate(const pointer location, const size_type size) PLF_NOEXCEPT
+	{
+		#if defined(__linux__)
+			if (is_mapped(size))
+			{
+				munmap(static_cast<void *>(location), mapped_size(size));
+				return;
+			}
+		#endif
+
+		std::allocator<element_type>::deallocate(location, size);
+	}
+
+
+
+	void discard(const pointer location, const size_type size) PLF_NOEXCEPT
+	{
+		plf::discard_pages(static_cast<void *>(location), size * sizeof(element_type)); // Memory policy is retained for discarded pages, so they will be faulted back in on the same node
+	}
+
+
+
+	friend bool operator == (const numa_allocator &lh, const numa_allocator &rh) PLF_NOEXCEPT
+	{
+		return lh.node == rh.node;
+	}
+
+
+
+	friend bool operator != (const numa_allocator &lh, const numa_allocator &rh) PLF_NOEXCEPT
+	{
+		return lh.node != rh.node;
+	}
+
+
+
+private:
+
+	#if defined(__linux__)
+		static bool is_mapped(const size_type size) PLF_NOEXCEPT
+		{
+			return size >= system_page_size() / sizeof(element_type) && size <= (static_cast<size_type>(-1) - system_page_size()) / sizeof(element_type);
+		}
+
+
+
+		static size_type mapped_size(const size_type size) PLF_NOEXCEPT
+		{
+			return ((size * sizeof(element_type)) + (system_page_size() - 1)) & ~(system_page_size() - 1);
+		}
+	#endif
+};
+
+
+} // plf namespace
+
+
+
+#ifdef PLF_QUEUE_ALLOCATORS_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_QUEUE_ALLOCATORS_H
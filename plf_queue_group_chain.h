@@ -0,0 +1,303 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+// Internal group chain shared by the queues which store their elements in raw, untyped group blocks (plf::byte_queue, plf::task_queue, plf::packed_queue and plf::compressed_queue).
+// Each group is a single allocation from plain ::operator new (there is no allocator parameter): the group header followed by it's storage. Reserved groups and group recycling behave as per plf::queue, with capacities in whatever unit the queue measures it's blocks in. Growth is fixed at plf::queue's plf::memory_use policy, as there is no priority parameter either.
+
+
+#ifndef PLF_QUEUE_GROUP_CHAIN_H
+#define PLF_QUEUE_GROUP_CHAIN_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_QUEUE_GROUP_CHAIN_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#include <cstddef> // std::size_t
+#include <limits>  // std::numeric_limits
+#include <new> // placement new, operator new
+#include <stdexcept> // std::length_error
+#include <utility> // std::swap
+
+
+
+namespace plf
+{
+
+
+// A group of bytes, with the storage starting at the first 'alignment' boundary after the header:
+template <std::size_t alignment>
+struct byte_group
+{
+	byte_group			*next_group, *previous_group;
+	const std::size_t	capacity; // in bytes
+	std::size_t			used; // bytes used in this group. Only updated for current_group when moving to the next group
+
+	byte_group(const std::size_t bytes, byte_group * const previous) PLF_NOEXCEPT:
+		next_group(NULL),
+		previous_group(previous),
+		capacity(bytes),
+		used(0)
+	{}
+
+	static PLF_CONSTFUNC std::size_t data_offset() PLF_NOEXCEPT
+	{
+		return (sizeof(byte_group) + (alignment - 1)) & ~(alignment - 1);
+	}
+
+	static PLF_CONSTFUNC std::size_t rounded_capacity(const std::size_t bytes) PLF_NOEXCEPT
+	{
+		return bytes;
+	}
+
+	static PLF_CONSTFUNC std::size_t allocation_size(const std::size_t bytes) PLF_NOEXCEPT
+	{
+		return data_offset() + bytes;
+	}
+
+	unsigned char * data() PLF_NOEXCEPT
+	{
+		return reinterpret_cast<unsigned char *>(this) + data_offset();
+	}
+};
+
+
+
+// group_type must supply next_group/previous_group pointers, a const capacity, a (capacity, previous) constructor, and static rounded_capacity(capacity) and allocation_size(capacity) functions, as per byte_group.
+// The queue inheriting from group_chain keeps it's own offsets into first_group and current_group, and must reset them when the chain moves on.
+template <class group_type>
+class group_chain
+{
+protected:
+	typedef std::size_t size_type;
+
+	group_type		*current_group, *first_group; // current group is the location of the back element, first_group is the 'front' group
+	size_type		total_size, total_capacity, min_block_capacity, max_block_capacity;
+
+
+
+	group_chain(const size_type min, const size_type max) PLF_NOEXCEPT:
+		current_group(NULL),
+		first_group(NULL),
+		total_size(0),
+		total_capacity(0),
+		min_block_capacity(min),
+		max_block_capacity(max)
+	{}
+
+
+
+	// smallest_min is the smallest block capacity the queue can store a single element in:
+	static void check_capacities_conformance(const size_type min, const size_type max, const size_type smallest_min)
+	{
+		if (min < smallest_min || min > max || max > (std::numeric_limits<size_type>::max() / 2))
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::length_error("Supplied memory block capacities outside of allowable ranges");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+
+	group_type * allocate_group(const size_type capacity, group_type * const previous)
+	{
+		const size_type rounded_capacity = group_type::rounded_capacity(capacity);
+		group_type * const new_group = ::new (::operator new(group_type::allocation_size(rounded_capacity))) group_type(rounded_capacity, previous);
+		total_capacity += rounded_capacity;
+		return new_group;
+	}
+
+
+
+	void deallocate_group(group_type * const the_group) PLF_NOEXCEPT
+	{
+		total_capacity -= the_group->capacity;
+		::operator delete(static_cast<void *>(the_group));
+	}
+
+
+
+	// Deallocates every group without adjusting the totals, for use prior to the queue blanking itself:
+	void deallocate_all_groups() PLF_NOEXCEPT
+	{
+		while (first_group != NULL)
+		{
+			group_type * const next_group = first_group->next_group;
+			::operator delete(static_cast<void *>(first_group));
+			first_group = next_group;
+		}
+	}
+
+
+
+	// Only called when there are no groups, at which point the queue's offsets are already zero:
+	void initialize(const size_type minimum_capacity)
+	{
+		first_group = current_group = allocate_group((minimum_capacity > min_block_capacity) ? minimum_capacity : min_block_capacity, NULL);
+	}
+
+
+
+	// Moves current_group on to the next reserved group with at least minimum_capacity, or to a new group. current_size is the queue's current size in block capacity units, which determines the new group's capacity as per plf::queue<..., plf::memory_use>'s progress_to_next_group:
+	void progress_to_next_group(const size_type current_size, const size_type minimum_capacity)
+	{
+		if (current_group->next_group == NULL || current_group->next_group->capacity < minimum_capacity) // no reserved group large enough, allocate new group
+		{
+			const size_type divided_size = current_size / plf::memory_use;
+			size_type new_group_capacity = ((divided_size < (current_group->capacity * 2)) & (divided_size > (current_group->capacity / 2))) ? current_group->capacity :
+														(divided_size < min_block_capacity) ? min_block_capacity :
+														(divided_size > max_block_capacity) ? max_block_capacity : divided_size;
+
+			if (new_group_capacity < minimum_capacity) new_group_capacity = minimum_capacity; // Oversized element gets a group of it's own size
+
+			group_type * const new_group = allocate_group(new_group_capacity, current_group);
+			new_group->next_group = current_group->next_group; // Keep any (too small) reserved groups after the new group
+
+			if (new_group->next_group != NULL) new_group->next_group->previous_group = new_group;
+
+			current_group->next_group = new_group;
+		}
+
+		current_group = current_group->next_group;
+
+		if (total_size == 0) // Only happens when the element is larger than the empty first group - move that group to the reserved groups, after the new current group
+		{
+			group_type * const empty_group = first_group;
+			first_group = current_group;
+			first_group->previous_group = NULL;
+			empty_group->next_group = current_group->next_group;
+
+			if (empty_group->next_group != NULL) empty_group->next_group->previous_group = empty_group;
+
+			current_group->next_group = empty_group;
+			empty_group->previous_group = current_group;
+		}
+	}
+
+
+
+	// Used by pop once every element in first_group has been popped, where first_group != current_group. The group is reused as a reserved group if it matches current_group's capacity and there are no others, otherwise deallocated:
+	void retire_first_group() PLF_NOEXCEPT
+	{
+		group_type * const next_group = first_group->next_group;
+
+		if (current_group->next_group == NULL && first_group->capacity == current_group->capacity)
+		{
+			current_group->next_group = first_group;
+			first_group->previous_group = current_group;
+			first_group->next_group = NULL;
+		}
+		else
+		{
+			deallocate_group(first_group);
+		}
+
+		first_group = next_group;
+		first_group->previous_group = NULL;
+	}
+
+
+
+	// Memory used by all groups, including their headers:
+	size_type groups_memory() const PLF_NOEXCEPT
+	{
+		size_type memory_use = 0;
+
+		for (const group_type *current = first_group; current != NULL; current = current->next_group)
+		{
+			memory_use += group_type::allocation_size(current->capacity);
+		}
+
+		return memory_use;
+	}
+
+
+
+	// Remove trailing groups (as may be created by reserve or pop)
+	void trim() PLF_NOEXCEPT
+	{
+		if (current_group == NULL) return;
+
+		group_type *temp_group = current_group->next_group;
+		current_group->next_group = NULL;
+
+		while (temp_group != NULL)
+		{
+			group_type * const next_group = temp_group->next_group;
+			deallocate_group(temp_group);
+			temp_group = next_group;
+		}
+	}
+
+
+
+	void reserve(const size_type reserve_amount)
+	{
+		if (reserve_amount <= total_capacity) return;
+
+		if (current_group == NULL)
+		{
+			initialize((reserve_amount > max_block_capacity) ? max_block_capacity : reserve_amount);
+		}
+
+		group_type *last_group = current_group;
+
+		while (last_group->next_group != NULL)
+		{
+			last_group = last_group->next_group;
+		}
+
+		while (total_capacity < reserve_amount)
+		{
+			const size_type remainder = reserve_amount - total_capacity;
+			last_group->next_group = allocate_group((remainder < min_block_capacity) ? min_block_capacity : (remainder > max_block_capacity) ? max_block_capacity : remainder, last_group);
+			last_group = last_group->next_group;
+		}
+	}
+
+
+
+	void swap_chain(group_chain &source) PLF_NOEXCEPT
+	{
+		std::swap(current_group, source.current_group);
+		std::swap(first_group, source.first_group);
+		std::swap(total_size, source.total_size);
+		std::swap(total_capacity, source.total_capacity);
+		std::swap(min_block_capacity, source.min_block_capacity);
+		std::swap(max_block_capacity, source.max_block_capacity);
+	}
+}; // group_chain
+
+
+} // plf namespace
+
+
+
+#ifdef PLF_QUEUE_GROUP_CHAIN_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_QUEUE_GROUP_CHAIN_H
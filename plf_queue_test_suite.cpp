@@ -2,12 +2,17 @@
 
 #include <cstdio> // log redirection
 #include <cstdlib> // abort
+#include <new> // std::bad_alloc
+#include <sstream> // save/load tests
+#include <string> // pop_while/erase_if tests
+#include <vector> // erase_if tests
 
 #ifdef PLF_MOVE_SEMANTICS_SUPPORT
 	#include <utility> // std::move
 #endif
 
 #include "plf_queue.h"
+#include "plf_queue_allocators.h"
 
 
 
@@ -63,6 +68,168 @@ void failpass(const char *test_type, bool condition)
 
 
 
+struct timestamped_entry
+{
+	unsigned int	timestamp;
+	std::string		name;
+
+	timestamped_entry(const unsigned int time, const std::string &entry_name):
+		timestamp(time),
+		name(entry_name)
+	{}
+};
+
+
+
+struct earlier_than
+{
+	bool operator () (const timestamped_entry &entry, const unsigned int cutoff) const
+	{
+		return entry.timestamp < cutoff;
+	}
+};
+
+
+
+struct is_even
+{
+	bool operator () (const int value) const
+	{
+		return value % 2 == 0;
+	}
+};
+
+
+
+struct is_multiple
+{
+	unsigned int divisor;
+
+	explicit is_multiple(const unsigned int value):
+		divisor(value)
+	{}
+
+	bool operator () (const unsigned int value) const
+	{
+		return value % divisor == 0;
+	}
+};
+
+
+
+struct has_short_name
+{
+	bool operator () (const timestamped_entry &entry) const
+	{
+		return entry.name.size() < 20;
+	}
+};
+
+
+
+#if defined(PLF_VOIDT_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+	struct block_statistics
+	{
+		size_t number_of_blocks, number_of_elements, capacity, nodes_matching, nodes_unknown;
+		int node;
+
+		block_statistics():
+			number_of_blocks(0),
+			number_of_elements(0),
+			capacity(0),
+			nodes_matching(0),
+			nodes_unknown(0),
+			node((plf::current_numa_node() < 0) ? 0 : plf::current_numa_node())
+		{}
+
+		void operator () (const unsigned int *block_begin, const unsigned int *block_end, const size_t block_size)
+		{
+			++number_of_blocks;
+			number_of_elements += block_size;
+			capacity += static_cast<size_t>(block_end - block_begin);
+
+			const int block_node = plf::numa_node_of(block_begin);
+			nodes_matching += (block_node == node);
+			nodes_unknown += (block_node == -1);
+		}
+	};
+
+
+
+
+
+	struct alignment_check
+	{
+		size_t alignment, number_misaligned;
+
+		explicit alignment_check(const size_t block_alignment):
+			alignment(block_alignment),
+			number_misaligned(0)
+		{}
+
+		void operator () (const double *block_begin, const double *block_end, const size_t)
+		{
+			number_misaligned += (reinterpret_cast<size_t>(block_begin) % alignment != 0) + (reinterpret_cast<size_t>(block_end) % alignment != 0);
+		}
+	};
+
+
+
+	size_t discard_calls = 0, discard_allocator_allocations = 0;
+
+	template <class element_type>
+	struct discard_counting_allocator : public std::allocator<element_type>
+	{
+		typedef element_type value_type;
+
+		template <class other_type> struct rebind { typedef discard_counting_allocator<other_type> other; };
+
+		discard_counting_allocator() {}
+
+		template <class other_type>
+		discard_counting_allocator(const discard_counting_allocator<other_type> &) {}
+
+		element_type * allocate(const size_t n)
+		{
+			++discard_allocator_allocations;
+			return std::allocator<element_type>::allocate(n);
+		}
+
+		void discard(element_type *, const size_t)
+		{
+			++discard_calls;
+		}
+	};
+#endif
+
+
+
+unsigned int allocations_remaining = 0;
+
+
+template <class element_type>
+struct failing_allocator : public std::allocator<element_type> // throws std::bad_alloc once allocations_remaining reaches zero
+{
+	typedef element_type value_type;
+
+	template <class other_type> struct rebind { typedef failing_allocator<other_type> other; };
+
+	failing_allocator() {}
+
+	template <class other_type>
+	failing_allocator(const failing_allocator<other_type> &) {}
+
+	element_type * allocate(const size_t size, const void * = 0)
+	{
+		if (allocations_remaining == 0) throw std::bad_alloc();
+
+		--allocations_remaining;
+		return std::allocator<element_type>::allocate(size);
+	}
+};
+
+
+
 int main()
 {
 	freopen("error.log","w", stderr);
@@ -280,8 +447,114 @@ int main()
  			}
 
  			failpass("queue copy special case test", temp2 == 2560);
+ 			// end() must match where incrementing past the back element lands when the back element fills current_group and reserved groups follow it:
+ 			queue<int> full_queue(8, 8);
+
+ 			for (int temp = 0; temp != 8; ++temp)
+ 			{
+ 				full_queue.push(temp);
+ 			}
+
+ 			full_queue.reserve(64);
+
+ 			const queue<int> &const_full_queue = full_queue;
+ 			int counter = 0, const_counter = 0;
+
+ 			for (queue<int>::iterator current = full_queue.begin(); current != full_queue.end() && counter != 100; ++current)
+ 			{
+ 				++counter;
+ 			}
+
+ 			for (queue<int>::const_iterator current = const_full_queue.cbegin(); current != const_full_queue.cend() && const_counter != 100; ++current)
+ 			{
+ 				++const_counter;
+ 			}
+
+ 			failpass("Full group followed by reserved groups iteration test", counter == 8 && const_counter == 8 && *(--full_queue.end()) == 7);
+
+ 			// Same again where the reserved group is a recycled front group, via pop():
+ 			queue<int> recycled_queue(8, 8);
+
+ 			for (int temp = 0; temp != 16; ++temp)
+ 			{
+ 				recycled_queue.push(temp);
+ 			}
+
+ 			for (int temp = 0; temp != 8; ++temp)
+ 			{
+ 				recycled_queue.pop();
+ 			}
+
+ 			counter = 0;
+
+ 			for (queue<int>::iterator current = recycled_queue.begin(); current != recycled_queue.end() && counter != 100; ++current)
+ 			{
+ 				++counter;
+ 			}
+
+ 			failpass("Full group followed by recycled group iteration test", counter == 8 && *(--recycled_queue.end()) == 15);
  		}
 
+ 		#ifdef PLF_EXCEPTIONS_SUPPORT
+ 		{
+ 			title2("Group allocation failure tests");
+
+ 			queue<int, plf::memory_use, failing_allocator<int> > f_queue(8, 8);
+ 			allocations_remaining = 2; // the first group's node and element block
+
+ 			for (int temp = 0; f_queue.empty() || f_queue.size() != f_queue.capacity(); ++temp)
+ 			{
+ 				f_queue.push(temp);
+ 			}
+
+ 			const int back_value = f_queue.back();
+ 			const size_t full_size = f_queue.size();
+ 			bool threw = false;
+
+ 			try
+ 			{
+ 				f_queue.push(-1);
+ 			}
+ 			catch (std::bad_alloc &)
+ 			{
+ 				threw = true;
+ 			}
+
+ 			failpass("Failed group allocation test", threw && f_queue.size() == full_size && f_queue.back() == back_value);
+
+ 			allocations_remaining = 1; // the new group's node but not it's element block
+ 			threw = false;
+
+ 			try
+ 			{
+ 				f_queue.push(-1);
+ 			}
+ 			catch (std::bad_alloc &)
+ 			{
+ 				threw = true;
+ 			}
+
+ 			failpass("Failed element block allocation test", threw && f_queue.size() == full_size && f_queue.back() == back_value);
+
+ 			allocations_remaining = 1000;
+
+ 			for (int temp = back_value + 1; temp != 100; ++temp)
+ 			{
+ 				f_queue.push(temp);
+ 			}
+
+ 			bool in_order = true;
+
+ 			for (int temp = 0; temp != 100; ++temp)
+ 			{
+ 				in_order = in_order && f_queue.front() == temp;
+ 				f_queue.pop();
+ 			}
+
+ 			failpass("Push after failed allocation test", in_order && f_queue.empty());
+ 		}
+ 		#endif
+
 
  		#ifdef PLF_VARIADICS_SUPPORT
  		{
@@ -300,6 +573,600 @@ int main()
  		#endif
 
 
+		#if defined(PLF_VOIDT_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+		{
+			title2("Block size class tests");
+
+			failpass("Size class test", plf::allocation_size_class(100) == 112 && plf::allocation_size_class(129) == 160 && plf::allocation_size_class(12289) == 14336);
+
+			queue<unsigned int, plf::memory_use, plf::size_class_allocator<unsigned int> > sc_queue(50, 1000);
+			sc_queue.push(1);
+
+			failpass("Rounded first block test", sc_queue.capacity() == 56); // 200 bytes -> 224 byte size class
+
+			unsigned int total = 1;
+
+			for (unsigned int temp = 1; temp != 10000; ++temp)
+			{
+				sc_queue.push(temp);
+				total += temp;
+			}
+
+			failpass("Rounded block capacity test", sc_queue.capacity() >= sc_queue.size() && (sc_queue.capacity() * sizeof(unsigned int)) % 32 == 0);
+
+			queue<unsigned int, plf::memory_use, plf::size_class_allocator<unsigned int> > sc_queue2(sc_queue);
+
+			do
+			{
+				total -= sc_queue2.front();
+				sc_queue2.pop();
+			} while (!sc_queue2.empty());
+
+			failpass("Rounded block copy test", total == 0);
+
+			total = 1 + ((9999 * 10000) / 2); // ie. sum of elements remaining in sc_queue
+			sc_queue.reserve(100000);
+			sc_queue.set_decay_threshold(3);
+
+			const size_t decay_capacity = sc_queue.capacity();
+
+			for (unsigned int temp = 0; temp != 9000; ++temp) // pop across several group boundaries without reaching the reserved groups
+			{
+				total -= sc_queue.front();
+				sc_queue.pop();
+			}
+
+			for (unsigned int temp = 0; temp != 90000; ++temp) // reuse discarded groups
+			{
+				sc_queue.push(temp);
+				total += temp;
+			}
+
+			failpass("Decay mode capacity test", sc_queue.capacity() >= decay_capacity - 10000 && sc_queue.decay_threshold() == 3);
+
+			sc_queue.decay();
+
+			do
+			{
+				total -= sc_queue.front();
+				sc_queue.pop();
+			} while (!sc_queue.empty());
+
+			failpass("Decay mode push/pop test", total == 0);
+
+			queue<unsigned int, plf::memory_use, discard_counting_allocator<unsigned int> > dc_queue(8, 8);
+			dc_queue.set_decay_threshold(1);
+			discard_calls = 0;
+
+			for (unsigned int temp = 0; temp != 1000; ++temp) // every push which crosses a group boundary allocates, so nothing should be discarded
+			{
+				dc_queue.push(temp);
+			}
+
+			failpass("Decay mode new group not discarded test", discard_calls == 0 && dc_queue.size() == 1000);
+
+			queue<unsigned int, plf::memory_use, discard_counting_allocator<unsigned int> > dc_queue2(8, 8);
+			dc_queue2.set_decay_threshold(2);
+			discard_calls = 0;
+
+			for (unsigned int temp = 0; temp != 64; ++temp) // fill exactly 8 groups
+			{
+				dc_queue2.push(temp);
+			}
+
+			for (unsigned int temp = 0; temp != 40; ++temp) // retire 5 front groups, passing the threshold
+			{
+				dc_queue2.pop();
+			}
+
+			failpass("Decay mode discard test", discard_calls > 0 && dc_queue2.size() == 24 && dc_queue2.front() == 40);
+
+			const size_t dc_capacity = dc_queue2.capacity(), dc_allocations = discard_allocator_allocations;
+
+			for (unsigned int temp = 64; temp != 72; ++temp) // fills the discarded reserved group
+			{
+				dc_queue2.push(temp);
+			}
+
+			failpass("Decay mode discarded group reuse test", discard_allocator_allocations == dc_allocations && dc_queue2.capacity() == dc_capacity && dc_queue2.size() == 32 && dc_queue2.back() == 71);
+
+			total = 0;
+
+			do
+			{
+				total += dc_queue2.front();
+				dc_queue2.pop();
+			} while (!dc_queue2.empty());
+
+			failpass("Decay mode discarded group contents test", total == (71 * 72) / 2 - (39 * 40) / 2);
+		}
+
+
+		{
+			title2("Huge page allocator tests");
+
+			typedef plf::huge_page_allocator<unsigned int> hp_allocator;
+			queue<unsigned int, plf::performance, hp_allocator> hp_queue(hp_allocator::huge_block_capacity(), hp_allocator::huge_block_capacity() * 2);
+
+			unsigned int total = 0;
+
+			for (unsigned int temp = 0; temp != 1500000; ++temp)
+			{
+				hp_queue.push(temp);
+				total += temp;
+			}
+
+			failpass("Huge page block capacity test", (hp_queue.capacity() * sizeof(unsigned int)) % 2097152 == 0);
+
+			for (unsigned int temp = 0; temp != 1000000; ++temp)
+			{
+				total -= hp_queue.front();
+				hp_queue.pop();
+			}
+
+			for (unsigned int temp = 0; temp != 1000000; ++temp)
+			{
+				hp_queue.push(temp);
+				total += temp;
+			}
+
+			do
+			{
+				total -= hp_queue.front();
+				hp_queue.pop();
+			} while (!hp_queue.empty());
+
+			failpass("Huge page push/pop test", total == 0);
+		}
+
+
+		{
+			title2("Aligned allocator tests");
+
+			queue<double, plf::performance, plf::aligned_allocator<double, 128> > aligned_queue(10, 1000);
+
+			double total = 0;
+
+			for (unsigned int temp = 0; temp != 50000; ++temp)
+			{
+				aligned_queue.push(static_cast<double>(temp));
+				total += static_cast<double>(temp);
+
+				if ((temp & 3) == 0)
+				{
+					total -= aligned_queue.front();
+					aligned_queue.pop();
+				}
+			}
+
+			const alignment_check alignment_result = aligned_queue.for_each_block(alignment_check(128));
+
+			failpass("Aligned block test", alignment_result.number_misaligned == 0);
+
+			queue<plf::padded_element<int> > padded_queue;
+			padded_queue.emplace(5);
+			padded_queue.emplace(6);
+
+			failpass("Padded element test", sizeof(plf::padded_element<int>) == 64 && static_cast<int>(padded_queue.front()) == 5 && reinterpret_cast<size_t>(&padded_queue.back()) % 64 == 0);
+
+			do
+			{
+				total -= aligned_queue.front();
+				aligned_queue.pop();
+			} while (!aligned_queue.empty());
+
+			failpass("Aligned push/pop test", total == 0);
+		}
+
+
+		{
+			title2("NUMA allocator tests");
+
+			const int node = (plf::current_numa_node() < 0) ? 0 : plf::current_numa_node();
+			const plf::numa_allocator<unsigned int> numa_alloc(node);
+			queue<unsigned int, plf::performance, plf::numa_allocator<unsigned int> > numa_queue(numa_alloc);
+
+			unsigned int total = 0;
+
+			for (unsigned int temp = 0; temp != 100000; ++temp)
+			{
+				numa_queue.push(temp);
+				total += temp;
+			}
+
+			for (unsigned int temp = 0; temp != 50000; ++temp)
+			{
+				total -= numa_queue.front();
+				numa_queue.pop();
+			}
+
+			failpass("NUMA allocator get_allocator test", numa_queue.get_allocator().node == node);
+
+			const block_statistics stats = numa_queue.for_each_block(block_statistics());
+
+			failpass("for_each_block test", stats.number_of_elements == numa_queue.size() && stats.capacity == numa_queue.capacity());
+			failpass("NUMA node placement test", stats.nodes_matching == stats.number_of_blocks || stats.nodes_unknown != 0);
+
+			do
+			{
+				total -= numa_queue.front();
+				numa_queue.pop();
+			} while (!numa_queue.empty());
+
+			failpass("NUMA allocator push/pop test", total == 0);
+		}
+		#endif
+
+
+		{
+			title2("Save/load tests");
+
+			queue<unsigned int> save_queue(8, 100);
+
+			for (unsigned int temp = 0; temp != 1000; ++temp)
+			{
+				save_queue.push(temp);
+			}
+
+			for (unsigned int temp = 0; temp != 55; ++temp)
+			{
+				save_queue.pop();
+			}
+
+			std::stringstream snapshot;
+
+			failpass("Stream save test", save_queue.save(snapshot));
+
+			queue<unsigned int> load_queue(8, 10000);
+			load_queue.push(12345);
+
+			failpass("Stream load test", load_queue.load(snapshot) && load_queue == save_queue);
+			failpass("Load group chain test", load_queue.capacity() == load_queue.size());
+
+			queue<unsigned int> small_queue(8, 100);
+			snapshot.seekg(0);
+
+			failpass("Multiple group load test", small_queue.load(snapshot) && small_queue == save_queue && small_queue.front() == 55 && small_queue.back() == 999);
+
+			small_queue.push(1000);
+
+			failpass("Post-load push test", small_queue.size() == 946 && small_queue.back() == 1000);
+
+			std::FILE *snapshot_file = std::tmpfile();
+
+			if (snapshot_file != NULL)
+			{
+				failpass("FILE save test", small_queue.save(snapshot_file));
+
+				std::rewind(snapshot_file);
+				queue<unsigned int> file_queue;
+
+				failpass("FILE load test", file_queue.load(snapshot_file) && file_queue == small_queue);
+
+				std::fclose(snapshot_file);
+			}
+
+			queue<unsigned int> empty_queue;
+			std::stringstream empty_snapshot;
+			empty_queue.save(empty_snapshot);
+			load_queue.load(empty_snapshot);
+
+			failpass("Empty snapshot test", load_queue.empty());
+
+			std::stringstream truncated_snapshot(snapshot.str().substr(0, 200));
+
+			failpass("Truncated snapshot test", !load_queue.load(truncated_snapshot) && load_queue.empty());
+
+			queue<unsigned short> short_queue;
+			snapshot.clear();
+			snapshot.seekg(0);
+
+			failpass("Element size mismatch test", !short_queue.load(snapshot) && short_queue.empty());
+
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				queue<unsigned int, plf::memory_use, failing_allocator<unsigned int> > failing_load_queue(8, 100), reference_capacity_queue(8, 100);
+				snapshot.clear();
+				snapshot.seekg(0);
+				allocations_remaining = 4; // the first two groups' nodes and element blocks, of the 10 groups needed
+
+				failpass("Load allocation failure test", !failing_load_queue.load(snapshot) && failing_load_queue.empty() && failing_load_queue.capacity() == 0);
+
+				snapshot.clear();
+				snapshot.seekg(0);
+				allocations_remaining = 0; // first group fails
+
+				failpass("Load first group allocation failure test", !failing_load_queue.load(snapshot) && failing_load_queue.empty());
+
+				allocations_remaining = 1000;
+				failing_load_queue.push(1);
+				reference_capacity_queue.push(1);
+
+				failpass("Block capacity restored after failed load test", failing_load_queue.capacity() == reference_capacity_queue.capacity());
+
+				snapshot.clear();
+				snapshot.seekg(0);
+
+				failpass("Load after allocation failure test", failing_load_queue.load(snapshot) && failing_load_queue.size() == save_queue.size() && failing_load_queue.front() == 55 && failing_load_queue.back() == 999);
+
+				failing_load_queue.push(1000);
+
+				failpass("Push after load test", failing_load_queue.back() == 1000 && failing_load_queue.size() == 946);
+			#endif
+		}
+
+
+		{
+			title2("pop_while tests");
+
+			queue<int> expiry_queue(8, 64);
+
+			failpass("Empty pop_while test", expiry_queue.pop_while_before(10) == 0);
+
+			for (int temp = 0; temp != 10000; ++temp)
+			{
+				expiry_queue.push(temp);
+			}
+
+			expiry_queue.pop();
+			expiry_queue.pop();
+			expiry_queue.pop();
+
+			failpass("Multiple group pop_while test", expiry_queue.pop_while_before(5000) == 4997 && expiry_queue.size() == 5000 && expiry_queue.front() == 5000);
+			failpass("No-op pop_while test", expiry_queue.pop_while_before(5000) == 0 && expiry_queue.front() == 5000);
+			failpass("Partial group pop_while test", expiry_queue.pop_while_before(5001) == 1 && expiry_queue.front() == 5001);
+
+			const queue<int>::size_type capacity = expiry_queue.capacity();
+
+			failpass("Pop everything test", expiry_queue.pop_while_before(20000) == 4999 && expiry_queue.empty() && expiry_queue.capacity() <= capacity && expiry_queue.capacity() != 0);
+
+			for (int temp = 0; temp != 1000; ++temp)
+			{
+				expiry_queue.push(temp * 2);
+			}
+
+			int total = 0;
+
+			for (queue<int>::iterator current = expiry_queue.begin(); current != expiry_queue.end(); ++current)
+			{
+				total += *current;
+			}
+
+			failpass("Push after pop_while test", expiry_queue.size() == 1000 && expiry_queue.front() == 0 && expiry_queue.back() == 1998 && total == 999000);
+			failpass("Predicate pop_while test", expiry_queue.pop_while(is_even()) == 1000 && expiry_queue.empty());
+
+			queue<unsigned int> reference_queue(8, 32), bulk_queue(8, 32);
+			unsigned int time = 0, seed = looper;
+			bool matches = true;
+
+			for (unsigned int counter = 0; counter != 2000 && matches; ++counter)
+			{
+				seed = seed * 1103515245 + 12345;
+
+				for (unsigned int pushes = (seed >> 16) % 60; pushes != 0; --pushes)
+				{
+					time += (seed >> 8) % 3;
+					reference_queue.push(time);
+					bulk_queue.push(time);
+				}
+
+				const unsigned int cutoff = time - ((seed >> 4) % 40);
+				unsigned int reference_popped = 0;
+
+				while (!reference_queue.empty() && reference_queue.front() < cutoff)
+				{
+					reference_queue.pop();
+					++reference_popped;
+				}
+
+				matches = bulk_queue.pop_while_before(cutoff) == reference_popped && bulk_queue == reference_queue;
+			}
+
+			failpass("Randomised pop_while test", matches);
+
+			queue<timestamped_entry> session_queue(4, 16);
+
+			for (unsigned int temp = 0; temp != 500; ++temp)
+			{
+				session_queue.push(timestamped_entry(temp / 3, std::string(temp % 40, 'x')));
+			}
+
+			failpass("Comparison function pop_while test", session_queue.pop_while_before(100u, earlier_than()) == 300 && session_queue.front().timestamp == 100 && session_queue.front().name.size() == 300 % 40);
+
+			session_queue.pop_while_before(1000u, earlier_than());
+
+			failpass("Non-trivial destruction test", session_queue.empty());
+
+			queue<int> recycled_queue(8, 8);
+
+			for (int temp = 0; temp != 16; ++temp)
+			{
+				recycled_queue.push(temp);
+			}
+
+			recycled_queue.pop_while_before(8); // front group is reused as a reserved group behind the full back group
+
+			int counter = 0, reverse_counter = 0;
+
+			for (queue<int>::iterator current = recycled_queue.begin(); current != recycled_queue.end(); ++current)
+			{
+				++counter;
+			}
+
+			for (queue<int>::reverse_iterator current = recycled_queue.rbegin(); current != recycled_queue.rend(); ++current)
+			{
+				++reverse_counter;
+			}
+
+			failpass("Reserved group iteration test", counter == 8 && reverse_counter == 8 && *(--recycled_queue.end()) == 15);
+		}
+
+
+		{
+			title2("erase_if tests");
+
+			queue<int> erase_queue(8, 64);
+
+			failpass("Empty erase_if test", erase_queue.erase_if(is_even()) == 0);
+
+			for (int temp = 0; temp != 10000; ++temp)
+			{
+				erase_queue.push(temp);
+			}
+
+			erase_queue.pop();
+
+			const queue<int>::size_type capacity = erase_queue.capacity();
+
+			failpass("erase_if count test", erase_queue.erase_if(is_even()) == 4999 && erase_queue.size() == 5000);
+
+			bool order = true;
+			int expected = 1;
+
+			for (queue<int>::iterator current = erase_queue.begin(); current != erase_queue.end(); ++current, expected += 2)
+			{
+				order = order && *current == expected;
+			}
+
+			failpass("erase_if order test", order && expected == 10001 && erase_queue.front() == 1 && erase_queue.back() == 9999);
+			failpass("erase_if front group retirement test", erase_queue.capacity() <= capacity);
+			failpass("No-op erase_if test", erase_queue.erase_if(is_even()) == 0 && erase_queue.size() == 5000);
+
+			erase_queue.push(10001);
+
+			failpass("Push after erase_if test", erase_queue.size() == 5001 && erase_queue.back() == 10001);
+
+			for (int temp = 0; temp != 5001; ++temp)
+			{
+				erase_queue.pop();
+			}
+
+			failpass("Pop after erase_if test", erase_queue.empty());
+
+			erase_queue.push(3);
+			erase_queue.push(4);
+
+			failpass("Erase everything test", erase_queue.erase_if(is_multiple(1)) == 2 && erase_queue.empty());
+
+			erase_queue.push(7);
+
+			failpass("Push after erasing everything test", erase_queue.size() == 1 && erase_queue.front() == 7 && erase_queue.back() == 7);
+
+			queue<unsigned int> bulk_queue(8, 32);
+			std::vector<unsigned int> reference;
+			unsigned int seed = looper;
+			bool matches = true;
+
+			for (unsigned int counter = 0; counter != 300 && matches; ++counter)
+			{
+				seed = seed * 1103515245 + 12345;
+
+				for (unsigned int pushes = (seed >> 16) % 200; pushes != 0; --pushes, seed = seed * 1103515245 + 12345)
+				{
+					bulk_queue.push(seed >> 8);
+					reference.push_back(seed >> 8);
+				}
+
+				for (unsigned int pops = (seed >> 4) % 50; pops != 0 && !reference.empty(); --pops)
+				{
+					bulk_queue.pop();
+					reference.erase(reference.begin());
+				}
+
+				const unsigned int divisor = 1 + (seed >> 12) % 5;
+				std::vector<unsigned int> survivors;
+
+				for (std::vector<unsigned int>::iterator current = reference.begin(); current != reference.end(); ++current)
+				{
+					if (*current % divisor != 0) survivors.push_back(*current);
+				}
+
+				matches = bulk_queue.erase_if(is_multiple(divisor)) == reference.size() - survivors.size() && bulk_queue.size() == survivors.size();
+				reference.swap(survivors);
+
+				std::vector<unsigned int>::iterator reference_current = reference.begin();
+
+				for (queue<unsigned int>::iterator current = bulk_queue.begin(); matches && current != bulk_queue.end(); ++current, ++reference_current)
+				{
+					matches = *current == *reference_current;
+				}
+			}
+
+			failpass("Randomised erase_if test", matches);
+
+			queue<timestamped_entry> session_queue(4, 16);
+
+			for (unsigned int temp = 0; temp != 500; ++temp)
+			{
+				session_queue.push(timestamped_entry(temp, std::string(temp % 40, 'x')));
+			}
+
+			failpass("Non-trivial erase_if test", session_queue.erase_if(has_short_name()) == 260 && session_queue.size() == 240 && session_queue.front().timestamp == 20 && session_queue.back().timestamp == 479 && session_queue.back().name.size() == 39);
+		}
+
+
+		{
+			title2("try_pop/pop_value tests");
+
+			queue<int> pop_queue(8, 64);
+			int value = -1;
+
+			failpass("Empty try_pop test", !pop_queue.try_pop(value) && value == -1);
+
+			for (int temp = 0; temp != 1000; ++temp)
+			{
+				pop_queue.push(temp);
+			}
+
+			int total = 0;
+			bool order = true;
+
+			for (int expected = 0; pop_queue.try_pop(value); ++expected)
+			{
+				order = order && value == expected;
+				total += value;
+			}
+
+			failpass("try_pop order test", order && total == 499500 && pop_queue.empty());
+
+			pop_queue.push(5);
+
+			failpass("Push after try_pop test", pop_queue.size() == 1 && pop_queue.front() == 5 && pop_queue.back() == 5);
+
+			queue<std::string> string_queue(4, 16);
+
+			for (unsigned int temp = 0; temp != 100; ++temp)
+			{
+				string_queue.push(std::string(temp, 'z'));
+			}
+
+			std::string text;
+			unsigned int length_total = 0;
+
+			while (string_queue.try_pop(text))
+			{
+				length_total += static_cast<unsigned int>(text.size());
+			}
+
+			failpass("Non-trivial try_pop test", length_total == 4950 && text.size() == 99 && string_queue.empty());
+
+			#ifdef PLF_OPTIONAL_SUPPORT
+				for (unsigned int temp = 0; temp != 100; ++temp)
+				{
+					string_queue.push(std::string(temp, 'y'));
+				}
+
+				length_total = 0;
+
+				while (std::optional<std::string> popped = string_queue.pop_value())
+				{
+					length_total += static_cast<unsigned int>(popped->size());
+				}
+
+				failpass("pop_value test", length_total == 4950 && string_queue.empty() && !string_queue.pop_value());
+			#endif
+		}
+
+
 		{
 			title1("Iterator tests");
 
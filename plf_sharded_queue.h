@@ -0,0 +1,454 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_SHARDED_QUEUE_H
+#define PLF_SHARDED_QUEUE_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_SHARDED_QUEUE_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT) && defined(PLF_ALIGNMENT_SUPPORT)
+
+#include <atomic> // std::atomic
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <mutex> // std::mutex, std::lock_guard
+#include <utility> // std::forward, std::move
+#include <vector> // shard registry, recycled batches
+
+#include "plf_queue.h"
+#include "plf_queue_allocators.h" // plf::aligned_allocator
+
+
+
+namespace plf
+{
+
+
+// plf::sharded_queue is a multiple-producer, single-consumer queue in which each producer pushes into it's own shard, so producers never contend with each other or share cache lines.
+// A producer obtains a shard with register_producer(), and pushes into a private plf::queue whose single group holds one batch. When the batch fills (or flush() is called) the whole queue is handed to the shard's published list under the shard's own mutex, and a previously-drained queue is taken back in exchange, so steady-state pushes neither lock nor allocate.
+// The consumer's collect() moves every published batch from every shard into a consumer-side queue, starting from a different shard each call so that no producer is persistently favoured. try_pop() and consume_all() read from the collected batches and call collect() themselves when those run out.
+// Ordering is FIFO per producer. Elements from different producers are interleaved at batch granularity.
+// All producer handles must be destroyed or released before the sharded_queue is destroyed. Before C++17 element_type must be copy-constructible, as for plf::queue.
+
+template <class element_type, plf::priority priority = plf::memory_use>
+class sharded_queue
+{
+public:
+	typedef element_type								value_type;
+	typedef std::size_t								size_type;
+	typedef plf::queue<element_type, priority>	batch_type;
+
+private:
+	struct alignas(64) shard // aligned so that neighbouring shards never share a cache line
+	{
+		// The producer-only local batch and the members shared with the consumer are kept on separate cache lines:
+		batch_type						local; // only accessed by the owning producer, or by collect() once detached
+		alignas(64) std::mutex		mutex; // guards published and recycled
+		plf::queue<batch_type>		published;
+		std::vector<batch_type>		recycled; // drained batches, ready to be reused as local
+		std::atomic<bool>				attached; // only set under the registry mutex, but cleared without it so that detaching cannot throw
+
+		explicit shard(const size_type batch_capacity):
+			local(batch_capacity, batch_capacity),
+			attached(true)
+		{}
+	};
+
+	struct collected_batch
+	{
+		shard			*origin;
+		batch_type	elements;
+
+		collected_batch(shard * const source, batch_type &&batch):
+			origin(source),
+			elements(std::move(batch))
+		{}
+	};
+
+	typedef plf::aligned_allocator<shard, 64> shard_allocator_type;
+
+	static PLF_CONSTFUNC size_type max_recycled_batches() PLF_NOEXCEPT
+	{
+		return 2;
+	}
+
+	std::mutex							registry_mutex;
+	std::vector<shard *>				shards;
+	plf::queue<collected_batch>	collected; // consumer-only
+	size_type							batch_capacity, next_shard;
+
+
+
+	// Hand a drained batch back to the shard it came from, so that it's group is reused rather than freed:
+	void recycle(collected_batch &batch)
+	{
+		std::lock_guard<std::mutex> lock(batch.origin->mutex);
+
+		if (batch.origin->recycled.size() < max_recycled_batches())
+		{
+			batch.origin->recycled.push_back(std::move(batch.elements));
+		}
+	}
+
+
+
+	// Drop any drained batches from the front of the collected queue:
+	bool front_batch_available()
+	{
+		while (!collected.empty())
+		{
+			if (!collected.front().elements.empty()) return true;
+
+			recycle(collected.front());
+			collected.pop();
+		}
+
+		return false;
+	}
+
+
+
+public:
+
+	// A producer's handle to it's shard. Move-only, and must only be used by one thread at a time:
+	class producer
+	{
+	private:
+		sharded_queue	*owner;
+		shard				*target;
+
+		friend class sharded_queue;
+
+		producer(sharded_queue * const queue_owner, shard * const queue_shard) PLF_NOEXCEPT:
+			owner(queue_owner),
+			target(queue_shard)
+		{}
+
+		void detach() PLF_NOEXCEPT
+		{
+			target->attached.store(false, std::memory_order_release); // publishes this thread's writes to local, for collect() and the next producer
+			owner = NULL;
+			target = NULL;
+		}
+
+
+		void flush_if_full()
+		{
+			if (target->local.size() >= owner->batch_capacity) flush();
+		}
+
+	public:
+
+		producer() PLF_NOEXCEPT:
+			owner(NULL),
+			target(NULL)
+		{}
+
+
+		producer(const producer &source) = delete;
+		producer & operator = (const producer &source) = delete;
+
+
+		producer(producer &&source) PLF_NOEXCEPT:
+			owner(source.owner),
+			target(source.target)
+		{
+			source.owner = NULL;
+			source.target = NULL;
+		}
+
+
+		producer & operator = (producer &&source)
+		{
+			assert(&source != this);
+			release();
+			owner = source.owner;
+			target = source.target;
+			source.owner = NULL;
+			source.target = NULL;
+			return *this;
+		}
+
+
+		// If the final flush fails, the unpublished elements are left in the shard, and collect() takes them once it is detached:
+		~producer()
+		{
+			if (target == NULL) return;
+
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				try
+				{
+					flush();
+				}
+				catch (...) // eg. std::bad_alloc from the hand-off, or std::system_error from locking
+				{}
+			#else
+				flush();
+			#endif
+
+			detach();
+		}
+
+
+		void push(const element_type &element)
+		{
+			assert(target != NULL);
+			target->local.push(element);
+			flush_if_full();
+		}
+
+
+		void push(element_type &&element)
+		{
+			assert(target != NULL);
+			target->local.push(std::move(element));
+			flush_if_full();
+		}
+
+
+		template<typename... arguments>
+		void emplace(arguments &&... parameters)
+		{
+			assert(target != NULL);
+			target->local.emplace(std::forward<arguments>(parameters)...);
+			flush_if_full();
+		}
+
+
+		// Publish any pushed elements to the consumer now, rather than waiting for the batch to fill:
+		void flush()
+		{
+			assert(target != NULL);
+
+			if (target->local.empty()) return;
+
+			std::lock_guard<std::mutex> lock(target->mutex);
+			target->published.push(std::move(target->local)); // the moved-from local keeps it's block capacity limits
+
+			if (!target->recycled.empty())
+			{
+				target->local = std::move(target->recycled.back());
+				target->recycled.pop_back();
+			}
+		}
+
+
+		// Flush and detach from the shard, which may then be reused by a later register_producer() call. If the flush throws, the handle remains attached:
+		void release()
+		{
+			if (target == NULL) return;
+
+			flush();
+			detach();
+		}
+
+
+		bool valid() const PLF_NOEXCEPT
+		{
+			return target != NULL;
+		}
+	};
+
+
+
+	// batch_size is the number of elements a producer accumulates before handing them to the consumer:
+	explicit sharded_queue(const size_type batch_size = 1024):
+		batch_capacity(batch_size),
+		next_shard(0)
+	{
+		assert(batch_size >= 2);
+	}
+
+
+
+	sharded_queue(const sharded_queue &source) = delete;
+	sharded_queue & operator = (const sharded_queue &source) = delete;
+
+
+
+	~sharded_queue()
+	{
+		shard_allocator_type allocator;
+
+		for (typename std::vector<shard *>::iterator current = shards.begin(); current != shards.end(); ++current)
+		{
+			assert(!(*current)->attached); // a producer handle has outlived the queue
+			(*current)->~shard();
+			allocator.deallocate(*current, 1);
+		}
+	}
+
+
+
+	// Thread-safe. Reuses a released shard if one is available:
+	producer register_producer()
+	{
+		std::lock_guard<std::mutex> lock(registry_mutex);
+
+		for (typename std::vector<shard *>::iterator current = shards.begin(); current != shards.end(); ++current)
+		{
+			if (!(*current)->attached.load(std::memory_order_acquire))
+			{
+				(*current)->attached.store(true, std::memory_order_relaxed);
+				return producer(this, *current);
+			}
+		}
+
+		shards.reserve(shards.size() + 1); // so that push_back below cannot throw after the shard is constructed
+		shard_allocator_type allocator;
+		shard * const new_shard = allocator.allocate(1);
+
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			try
+			{
+				::new (static_cast<void *>(new_shard)) shard(batch_capacity);
+			}
+			catch (...)
+			{
+				allocator.deallocate(new_shard, 1);
+				throw;
+			}
+		#else
+			::new (static_cast<void *>(new_shard)) shard(batch_capacity);
+		#endif
+
+		shards.push_back(new_shard);
+		return producer(this, new_shard);
+	}
+
+
+
+	// Consumer-only. Moves every published batch into the consumer side, and returns the number of batches collected:
+	size_type collect()
+	{
+		std::lock_guard<std::mutex> registry_lock(registry_mutex);
+
+		const size_type shard_count = shards.size();
+		size_type batch_count = 0;
+
+		for (size_type counter = 0; counter != shard_count; ++counter)
+		{
+			shard * const current = shards[(next_shard + counter) % shard_count];
+			std::lock_guard<std::mutex> lock(current->mutex);
+
+			for (; !current->published.empty(); current->published.pop(), ++batch_count)
+			{
+				collected.emplace(current, std::move(current->published.front()));
+			}
+
+			if (!current->attached.load(std::memory_order_acquire) && !current->local.empty()) // left behind by a producer whose final flush failed - safe to take, as re-attaching requires the registry mutex
+			{
+				collected.emplace(current, std::move(current->local));
+				++batch_count;
+			}
+		}
+
+		if (shard_count != 0) next_shard = (next_shard + 1) % shard_count;
+
+		return batch_count;
+	}
+
+
+
+	// Consumer-only. Returns false if no element was available from any shard:
+	bool try_pop(element_type &destination)
+	{
+		if (!front_batch_available())
+		{
+			collect();
+
+			if (!front_batch_available()) return false;
+		}
+
+		return collected.front().elements.try_pop(destination);
+	}
+
+
+
+	// Consumer-only. Calls function with each available element in turn, popping it afterwards, and returns the number consumed:
+	template <class function_type>
+	size_type consume_all(function_type function)
+	{
+		size_type count = 0;
+		collect();
+
+		while (front_batch_available())
+		{
+			batch_type &batch = collected.front().elements;
+
+			for (; !batch.empty(); batch.pop(), ++count)
+			{
+				function(batch.front());
+			}
+		}
+
+		return count;
+	}
+
+
+
+	// Consumer-only. The number of elements already collected and not yet popped; elements still held by producers are not counted:
+	size_type collected_size() const PLF_NOEXCEPT
+	{
+		size_type total = 0;
+		typename plf::queue<collected_batch>::const_iterator current = collected.begin();
+
+		for (size_type remaining = collected.size(); remaining != 0; --remaining, ++current)
+		{
+			total += current->elements.size();
+		}
+
+		return total;
+	}
+
+
+
+	size_type batch_size() const PLF_NOEXCEPT
+	{
+		return batch_capacity;
+	}
+
+
+
+	size_type shard_count()
+	{
+		std::lock_guard<std::mutex> lock(registry_mutex);
+		return shards.size();
+	}
+}; // sharded_queue
+
+
+} // plf namespace
+
+
+#endif // PLF_VARIADICS_SUPPORT etc
+
+
+#ifdef PLF_SHARDED_QUEUE_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_SHARDED_QUEUE_H
@@ -0,0 +1,231 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+#include <string> // std::string elements
+
+#include "plf_sharded_queue.h"
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT) && defined(PLF_ALIGNMENT_SUPPORT)
+	#include <thread> // std::thread, std::this_thread::yield
+	#include <utility> // std::move
+	#include <vector> // per-producer bookkeeping
+#endif
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT) && defined(PLF_ALIGNMENT_SUPPORT)
+	struct tagged_value
+	{
+		unsigned int producer, sequence;
+
+		tagged_value(): producer(0), sequence(0) {}
+		tagged_value(const unsigned int source, const unsigned int number): producer(source), sequence(number) {}
+	};
+
+
+	void produce(plf::sharded_queue<tagged_value> *s_queue, const unsigned int producer_number, const unsigned int count)
+	{
+		plf::sharded_queue<tagged_value>::producer handle = s_queue->register_producer();
+
+		for (unsigned int counter = 0; counter != count; ++counter)
+		{
+			handle.emplace(producer_number, counter);
+		}
+	} // handle's destructor flushes the remainder
+#endif
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT) && defined(PLF_ALIGNMENT_SUPPORT)
+		unsigned int looper = 0;
+
+		while (++looper != 20)
+		{
+			{
+				title1("Test basics");
+
+				sharded_queue<int> s_queue(4);
+				int value = 0;
+
+				failpass("Empty test", !s_queue.try_pop(value) && s_queue.shard_count() == 0 && s_queue.batch_size() == 4);
+
+				{
+					sharded_queue<int>::producer handle = s_queue.register_producer();
+
+					failpass("Register test", handle.valid() && s_queue.shard_count() == 1);
+
+					handle.push(1);
+					handle.push(2);
+					handle.push(3);
+
+					failpass("Partial batch not yet visible test", !s_queue.try_pop(value));
+
+					handle.push(4);
+
+					failpass("Full batch handoff test", s_queue.try_pop(value) && value == 1 && s_queue.collected_size() == 3);
+
+					handle.push(5);
+					handle.flush();
+
+					s_queue.try_pop(value);
+					s_queue.try_pop(value);
+					s_queue.try_pop(value);
+
+					failpass("Flush test", value == 4 && s_queue.try_pop(value) && value == 5 && !s_queue.try_pop(value));
+
+					handle.push(6);
+					sharded_queue<int>::producer moved_handle(std::move(handle));
+
+					failpass("Move handle test", !handle.valid() && moved_handle.valid());
+
+					moved_handle.release();
+
+					failpass("Release flushes test", !moved_handle.valid() && s_queue.try_pop(value) && value == 6);
+				}
+
+				{
+					sharded_queue<int>::producer handle = s_queue.register_producer();
+
+					failpass("Released shard reuse test", s_queue.shard_count() == 1);
+
+					sharded_queue<int>::producer handle2 = s_queue.register_producer();
+
+					failpass("Second shard test", s_queue.shard_count() == 2);
+
+					for (int counter = 0; counter != 8; ++counter)
+					{
+						handle.push(counter);
+						handle2.push(counter + 100);
+					}
+
+					int total = 0;
+					const std::size_t consumed = s_queue.consume_all([&total](const int element) { total += element; });
+
+					failpass("Consume all test", consumed == 16 && total == 28 + 828 && s_queue.collected_size() == 0);
+				}
+
+				failpass("Shards retained test", s_queue.shard_count() == 2);
+			}
+
+
+			{
+				title2("Non-trivial type tests");
+
+				sharded_queue<std::string> s_queue(16);
+				bool matches = true;
+				std::string value;
+
+				{
+					sharded_queue<std::string>::producer handle = s_queue.register_producer();
+
+					for (unsigned int counter = 0; counter != 1000; ++counter)
+					{
+						handle.push(std::string(counter % 40, 'a'));
+
+						if ((counter % 37) == 0)
+						{
+							while (s_queue.try_pop(value))
+							{
+								matches = matches && value.size() < 40 && value == std::string(value.size(), 'a');
+							}
+						}
+					}
+				}
+
+				unsigned int remaining = 0;
+
+				while (s_queue.try_pop(value))
+				{
+					++remaining;
+				}
+
+				failpass("Interleaved push/pop test", matches && remaining != 0 && !s_queue.try_pop(value));
+			}
+
+
+			{
+				title2("Multiple producer tests");
+
+				const unsigned int producer_count = 8, per_producer = 20000;
+				sharded_queue<tagged_value> s_queue(64);
+				std::vector<std::thread> producers;
+
+				for (unsigned int producer_number = 0; producer_number != producer_count; ++producer_number)
+				{
+					producers.push_back(std::thread(produce, &s_queue, producer_number, per_producer));
+				}
+
+				std::vector<unsigned int> next_expected(producer_count, 0);
+				unsigned int received = 0;
+				bool in_order = true;
+				tagged_value value;
+
+				while (received != producer_count * per_producer && in_order)
+				{
+					if (s_queue.try_pop(value))
+					{
+						in_order = value.producer < producer_count && value.sequence == next_expected[value.producer]++;
+						++received;
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+				}
+
+				for (std::vector<std::thread>::iterator current = producers.begin(); current != producers.end(); ++current)
+				{
+					current->join();
+				}
+
+				failpass("Per-producer FIFO order test", in_order);
+				failpass("All elements received test", received == producer_count * per_producer && !s_queue.try_pop(value));
+				failpass("Shard count test", s_queue.shard_count() >= 1 && s_queue.shard_count() <= producer_count);
+			}
+		}
+	#endif
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
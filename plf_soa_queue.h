@@ -0,0 +1,730 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_SOA_QUEUE_H
+#define PLF_SOA_QUEUE_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_SOA_QUEUE_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t, std::max_align_t
+#include <limits>  // std::numeric_limits
+#include <new> // placement new, operator new
+#include <stdexcept> // std::length_error
+#include <tuple> // std::tuple, std::get
+#include <type_traits> // std::is_trivially_destructible, std::tuple_element
+#include <utility> // std::forward, std::move, std::swap
+
+
+
+namespace plf
+{
+
+
+// plf::soa_queue is a structure-of-arrays version of plf::queue: each group stores one parallel array per field, so that consumers which only read some fields, or scan a single field across the backlog, only pull those fields into cache.
+// Group chain, growth and group recycling behaviour matches plf::queue. Each group (header and arrays) is a single allocation. Fields must not be over-aligned ie. alignof(field) <= alignof(std::max_align_t).
+
+template <class... field_types>
+class soa_queue
+{
+public:
+	typedef std::size_t					size_type;
+	typedef std::tuple<field_types...>		value_type;
+	typedef std::tuple<field_types &...>	reference;
+	typedef std::tuple<const field_types &...>	const_reference;
+
+	template <std::size_t field_index>
+	struct field
+	{
+		typedef typename std::tuple_element<field_index, value_type>::type type;
+	};
+
+	static const std::size_t number_of_fields = sizeof...(field_types);
+
+private:
+	template <std::size_t... indices> struct index_sequence {};
+	template <std::size_t count, std::size_t... indices> struct make_index_sequence : make_index_sequence<count - 1, count - 1, indices...> {};
+	template <std::size_t... indices> struct make_index_sequence<0, indices...> { typedef index_sequence<indices...> type; };
+	typedef typename make_index_sequence<sizeof...(field_types)>::type field_indices;
+
+
+	template <class... types> struct sum_of_sizes { static const std::size_t value = 0; };
+	template <class type, class... types> struct sum_of_sizes<type, types...> { static const std::size_t value = sizeof(type) + sum_of_sizes<types...>::value; };
+
+	template <class... types> struct all_trivially_destructible { static const bool value = true; };
+	template <class type, class... types> struct all_trivially_destructible<type, types...> { static const bool value = std::is_trivially_destructible<type>::value && all_trivially_destructible<types...>::value; };
+
+	template <class... types> struct maximum_alignment { static const std::size_t value = 1; };
+	template <class type, class... types> struct maximum_alignment<type, types...> { static const std::size_t value = (alignof(type) > maximum_alignment<types...>::value) ? alignof(type) : maximum_alignment<types...>::value; };
+
+	static_assert(sizeof...(field_types) != 0, "plf::soa_queue requires at least one field");
+	static_assert(maximum_alignment<field_types...>::value <= alignof(std::max_align_t), "plf::soa_queue does not support over-aligned field types");
+
+	static const std::size_t element_size = sum_of_sizes<field_types...>::value;
+
+
+
+	struct group
+	{
+		std::tuple<field_types *...>	fields;
+		group *							next_group, *previous_group;
+		const size_type					capacity;
+		const size_type					bytes; // size of the allocation, including this header
+
+		group(const size_type elements_per_group, const size_type allocation_size, group * const previous) PLF_NOEXCEPT:
+			next_group(NULL),
+			previous_group(previous),
+			capacity(elements_per_group),
+			bytes(allocation_size)
+		{}
+	};
+
+
+
+	group			*current_group, *first_group; // current group is the location of the back element, first_group is the 'front' group
+	size_type		start_index, top_index; // index of front element within first_group, and one-past the back element within current_group
+	size_type		total_size, total_capacity, min_block_capacity, max_block_capacity;
+
+
+
+	static PLF_CONSTFUNC size_type align_up(const size_type offset, const size_type alignment) PLF_NOEXCEPT
+	{
+		return (offset + (alignment - 1)) & ~(alignment - 1);
+	}
+
+
+
+	// Calculates the byte offset of each field's array within a group allocation and returns the total allocation size:
+	template <std::size_t... indices>
+	static size_type layout(const size_type capacity, size_type (&offsets)[sizeof...(field_types)], index_sequence<indices...>) PLF_NOEXCEPT
+	{
+		size_type offset = sizeof(group);
+		const int dummy[] = {0, ((offset = align_up(offset, alignof(typename field<indices>::type))), (offsets[indices] = offset), (offset += capacity * sizeof(typename field<indices>::type)), 0)...};
+		static_cast<void>(dummy);
+		return offset;
+	}
+
+
+
+	template <std::size_t... indices>
+	static void assign_fields(group * const the_group, const size_type (&offsets)[sizeof...(field_types)], index_sequence<indices...>) PLF_NOEXCEPT
+	{
+		unsigned char * const storage = reinterpret_cast<unsigned char *>(the_group);
+		the_group->fields = std::tuple<field_types *...>(reinterpret_cast<field_types *>(storage + offsets[indices])...);
+	}
+
+
+
+	void check_capacities_conformance(const size_type min, const size_type max) const
+	{
+		if (min < 2 || min > max || max > (std::numeric_limits<size_type>::max() / (element_size * 2)))
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::length_error("Supplied memory block capacities outside of allowable ranges");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+
+	group * allocate_group(const size_type capacity, group * const previous)
+	{
+		size_type offsets[sizeof...(field_types)];
+		const size_type bytes = layout(capacity, offsets, field_indices());
+		group * const new_group = ::new (::operator new(bytes)) group(capacity, bytes, previous);
+		assign_fields(new_group, offsets, field_indices());
+		total_capacity += capacity;
+		return new_group;
+	}
+
+
+
+	static void deallocate_group(group * const the_group) PLF_NOEXCEPT
+	{
+		the_group->~group();
+		::operator delete(static_cast<void *>(the_group));
+	}
+
+
+
+	void initialize()
+	{
+		first_group = current_group = allocate_group(min_block_capacity, NULL);
+		start_index = top_index = 0;
+	}
+
+
+
+	void progress_to_next_group() // used by push/emplace
+	{
+		if (current_group->next_group == NULL) // no reserved groups or groups left over from previous pops, allocate new group
+		{
+			// Same logic as plf::queue - see plf_queue.h:
+			const size_type divided_size = total_size / plf::memory_use;
+			const size_type new_group_capacity = ((divided_size < (current_group->capacity * 2)) & (divided_size > (current_group->capacity / 2))) ? current_group->capacity :
+															(divided_size < min_block_capacity) ? min_block_capacity :
+															(divided_size > max_block_capacity) ? max_block_capacity : divided_size;
+			current_group->next_group = allocate_group(new_group_capacity, current_group);
+		}
+
+		current_group = current_group->next_group;
+		top_index = 0;
+	}
+
+
+
+	template <std::size_t field_index>
+	static void construct_fields(group * const, const size_type) PLF_NOEXCEPT
+	{}
+
+
+
+	// Construct each field in turn, destroying already-constructed fields if a subsequent field's constructor throws:
+	template <std::size_t field_index, class argument, class... arguments>
+	static void construct_fields(group * const the_group, const size_type index, argument &&parameter, arguments &&... parameters)
+	{
+		typedef typename field<field_index>::type field_type;
+		field_type * const location = std::get<field_index>(the_group->fields) + index;
+		::new (static_cast<void *>(location)) field_type(std::forward<argument>(parameter));
+
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			if PLF_CONSTEXPR (sizeof...(arguments) != 0)
+			{
+				try
+				{
+					construct_fields<field_index + 1>(the_group, index, std::forward<arguments>(parameters)...);
+				}
+				catch (...)
+				{
+					location->~field_type();
+					throw;
+				}
+			}
+		#else
+			construct_fields<field_index + 1>(the_group, index, std::forward<arguments>(parameters)...);
+		#endif
+	}
+
+
+
+	template <std::size_t... indices>
+	static void destroy_fields(group * const the_group, const size_type index, index_sequence<indices...>) PLF_NOEXCEPT
+	{
+		const int dummy[] = {0, (destroy_field(std::get<indices>(the_group->fields) + index), 0)...};
+		static_cast<void>(dummy);
+	}
+
+
+
+	template <class field_type>
+	static void destroy_field(field_type * const location) PLF_NOEXCEPT
+	{
+		location->~field_type();
+	}
+
+
+
+	template <std::size_t... indices>
+	static reference get_reference(group * const the_group, const size_type index, index_sequence<indices...>) PLF_NOEXCEPT
+	{
+		return reference(std::get<indices>(the_group->fields)[index]...);
+	}
+
+
+
+	template <std::size_t... indices>
+	void push_from(const group * const the_group, const size_type index, index_sequence<indices...>)
+	{
+		push(std::get<indices>(the_group->fields)[index]...);
+	}
+
+
+
+	template <std::size_t... indices>
+	void push_moved_from(const group * const the_group, const size_type index, index_sequence<indices...>)
+	{
+		push(std::move(std::get<indices>(the_group->fields)[index])...);
+	}
+
+
+
+	template <std::size_t... indices>
+	void push_tuple(const value_type &element, index_sequence<indices...>)
+	{
+		push(std::get<indices>(element)...);
+	}
+
+
+
+	void copy_from_source(const soa_queue &source)
+	{
+		if (source.total_size == 0) return;
+
+		for (const group *current = source.first_group; ; current = current->next_group)
+		{
+			const size_type end_index = (current == source.current_group) ? source.top_index : current->capacity;
+
+			for (size_type index = (current == source.first_group) ? source.start_index : 0; index != end_index; ++index)
+			{
+				push_from(current, index, field_indices());
+			}
+
+			if (current == source.current_group) break;
+		}
+	}
+
+
+
+	void destroy_all_data() PLF_NOEXCEPT
+	{
+		if (!all_trivially_destructible<field_types...>::value && total_size != 0)
+		{
+			for (group *current = first_group; ; current = current->next_group)
+			{
+				const size_type end_index = (current == current_group) ? top_index : current->capacity;
+
+				for (size_type index = (current == first_group) ? start_index : 0; index != end_index; ++index)
+				{
+					destroy_fields(current, index, field_indices());
+				}
+
+				if (current == current_group) break;
+			}
+		}
+
+		while (first_group != NULL)
+		{
+			group * const next_group = first_group->next_group;
+			deallocate_group(first_group);
+			first_group = next_group;
+		}
+
+		current_group = NULL;
+		start_index = top_index = total_size = total_capacity = 0;
+	}
+
+
+
+	void blank() PLF_NOEXCEPT
+	{
+		current_group = first_group = NULL;
+		start_index = top_index = total_size = total_capacity = 0;
+	}
+
+
+
+public:
+
+	static PLF_CONSTFUNC size_type default_min_block_capacity() PLF_NOEXCEPT
+	{
+		return ((element_size * 8 > (sizeof(soa_queue) + sizeof(group)) * 2) ? 8 : (((sizeof(soa_queue) + sizeof(group)) * 2) / element_size) + 1) / plf::memory_use;
+	}
+
+
+
+	static PLF_CONSTFUNC size_type default_max_block_capacity() PLF_NOEXCEPT
+	{
+		return ((element_size > 128) ? 768 : 12288 / element_size) / plf::memory_use;
+	}
+
+
+
+	soa_queue() PLF_NOEXCEPT:
+		current_group(NULL),
+		first_group(NULL),
+		start_index(0),
+		top_index(0),
+		total_size(0),
+		total_capacity(0),
+		min_block_capacity((default_min_block_capacity() < 2) ? 2 : default_min_block_capacity()),
+		max_block_capacity((default_max_block_capacity() < min_block_capacity) ? min_block_capacity : default_max_block_capacity())
+	{}
+
+
+
+	// Constructor with limits:
+	soa_queue(const size_type min, const size_type max = default_max_block_capacity()):
+		current_group(NULL),
+		first_group(NULL),
+		start_index(0),
+		top_index(0),
+		total_size(0),
+		total_capacity(0),
+		min_block_capacity(min),
+		max_block_capacity(max)
+	{
+		check_capacities_conformance(min, max);
+	}
+
+
+
+	soa_queue(const soa_queue &source):
+		current_group(NULL),
+		first_group(NULL),
+		start_index(0),
+		top_index(0),
+		total_size(0),
+		total_capacity(0),
+		min_block_capacity(source.min_block_capacity),
+		max_block_capacity(source.max_block_capacity)
+	{
+		copy_from_source(source);
+	}
+
+
+
+	soa_queue(soa_queue &&source) PLF_NOEXCEPT:
+		current_group(source.current_group),
+		first_group(source.first_group),
+		start_index(source.start_index),
+		top_index(source.top_index),
+		total_size(source.total_size),
+		total_capacity(source.total_capacity),
+		min_block_capacity(source.min_block_capacity),
+		max_block_capacity(source.max_block_capacity)
+	{
+		source.blank();
+	}
+
+
+
+	~soa_queue() PLF_NOEXCEPT
+	{
+		destroy_all_data();
+	}
+
+
+
+	soa_queue & operator = (const soa_queue &source)
+	{
+		assert(&source != this);
+
+		soa_queue temp(source);
+		swap(temp);
+		return *this;
+	}
+
+
+
+	soa_queue & operator = (soa_queue &&source) PLF_NOEXCEPT
+	{
+		assert(&source != this);
+
+		destroy_all_data();
+		current_group = source.current_group;
+		first_group = source.first_group;
+		start_index = source.start_index;
+		top_index = source.top_index;
+		total_size = source.total_size;
+		total_capacity = source.total_capacity;
+		min_block_capacity = source.min_block_capacity;
+		max_block_capacity = source.max_block_capacity;
+		source.blank();
+		return *this;
+	}
+
+
+
+	// Takes one argument per field, in field order, each of which is used to construct that field:
+	template <class... arguments>
+	typename plf::enable_if<sizeof...(arguments) == sizeof...(field_types)>::type push(arguments &&... parameters)
+	{
+		if (current_group == NULL)
+		{
+			initialize();
+		}
+		else if (top_index == current_group->capacity) // ie. out of capacity for current element memory block
+		{
+			progress_to_next_group();
+		}
+
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			try
+			{
+				construct_fields<0>(current_group, top_index, std::forward<arguments>(parameters)...);
+			}
+			catch (...)
+			{
+				if (top_index == 0 && current_group != first_group) // ie. progressed to next group, roll back to previous group
+				{
+					current_group = current_group->previous_group;
+					top_index = current_group->capacity;
+				}
+
+				throw;
+			}
+		#else
+			construct_fields<0>(current_group, top_index, std::forward<arguments>(parameters)...);
+		#endif
+
+		++top_index;
+		++total_size;
+	}
+
+
+
+	void push(const value_type &element)
+	{
+		push_tuple(element, field_indices());
+	}
+
+
+
+	reference front() const PLF_NOEXCEPT // Undefined behaviour if queue is empty
+	{
+		assert(total_size != 0);
+		return get_reference(first_group, start_index, field_indices());
+	}
+
+
+
+	reference back() const PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+		return get_reference(current_group, top_index - 1, field_indices());
+	}
+
+
+
+	template <std::size_t field_index>
+	typename field<field_index>::type & front() const PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+		return std::get<field_index>(first_group->fields)[start_index];
+	}
+
+
+
+	template <std::size_t field_index>
+	typename field<field_index>::type & back() const PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+		return std::get<field_index>(current_group->fields)[top_index - 1];
+	}
+
+
+
+	void pop() PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+
+		if (!all_trivially_destructible<field_types...>::value)
+		{
+			destroy_fields(first_group, start_index, field_indices());
+		}
+
+		if (--total_size == 0)
+		{
+			start_index = top_index = 0;
+		}
+		else if (++start_index == first_group->capacity)
+		{ // ie. is start element, but not first group in queue
+			group * const next_group = first_group->next_group;
+
+			if (current_group->next_group == NULL && first_group->capacity == current_group->capacity)
+			{
+				current_group->next_group = first_group;
+				first_group->previous_group = current_group;
+				first_group->next_group = NULL;
+			}
+			else
+			{
+				total_capacity -= first_group->capacity;
+				deallocate_group(first_group);
+			}
+
+			first_group = next_group;
+			first_group->previous_group = NULL;
+			start_index = 0;
+		}
+	}
+
+
+
+	// Calls function(first, last) for each contiguous run of the given field's stored values, front to back. Pointers are const field pointers. As per std::for_each, returns the function object:
+	template <std::size_t field_index, class function_type>
+	function_type for_each_segment(function_type function) const
+	{
+		if (total_size == 0) return function;
+
+		for (const group *current = first_group; ; current = current->next_group)
+		{
+			const typename field<field_index>::type * const elements = std::get<field_index>(current->fields);
+			function(elements + ((current == first_group) ? start_index : 0), elements + ((current == current_group) ? top_index : current->capacity));
+
+			if (current == current_group) break;
+		}
+
+		return function;
+	}
+
+
+
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() const PLF_NOEXCEPT
+	{
+		return total_size == 0;
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return total_size;
+	}
+
+
+
+	size_type capacity() const PLF_NOEXCEPT
+	{
+		return total_capacity;
+	}
+
+
+
+	size_type memory() const PLF_NOEXCEPT
+	{
+		size_type memory_use = sizeof(*this);
+
+		for (const group *current = first_group; current != NULL; current = current->next_group)
+		{
+			memory_use += current->bytes;
+		}
+
+		return memory_use;
+	}
+
+
+
+	void reshape(const size_type min, const size_type max)
+	{
+		check_capacities_conformance(min, max);
+		min_block_capacity = min;
+		max_block_capacity = max; // Existing groups are kept, unlike plf::queue, as they are reused as-is
+	}
+
+
+
+	void clear() PLF_NOEXCEPT
+	{
+		destroy_all_data();
+	}
+
+
+
+	// Remove trailing groups (as may be created by reserve or pop)
+	void trim() PLF_NOEXCEPT
+	{
+		if (current_group == NULL) return;
+
+		group *temp_group = current_group->next_group;
+		current_group->next_group = NULL;
+
+		while (temp_group != NULL)
+		{
+			group * const next_group = temp_group->next_group;
+			total_capacity -= temp_group->capacity;
+			deallocate_group(temp_group);
+			temp_group = next_group;
+		}
+	}
+
+
+
+	void reserve(const size_type reserve_amount)
+	{
+		if (reserve_amount <= total_capacity) return;
+
+		if (current_group == NULL)
+		{
+			const size_type original_min_block_capacity = min_block_capacity;
+			min_block_capacity = (reserve_amount < min_block_capacity) ? min_block_capacity : (reserve_amount > max_block_capacity) ? max_block_capacity : reserve_amount;
+			initialize();
+			min_block_capacity = original_min_block_capacity;
+		}
+
+		group *last_group = current_group;
+
+		while (last_group->next_group != NULL)
+		{
+			last_group = last_group->next_group;
+		}
+
+		while (total_capacity < reserve_amount)
+		{
+			const size_type remainder = reserve_amount - total_capacity;
+			last_group->next_group = allocate_group((remainder < min_block_capacity) ? min_block_capacity : (remainder > max_block_capacity) ? max_block_capacity : remainder, last_group);
+			last_group = last_group->next_group;
+		}
+	}
+
+
+
+	void swap(soa_queue &source) PLF_NOEXCEPT
+	{
+		std::swap(current_group, source.current_group);
+		std::swap(first_group, source.first_group);
+		std::swap(start_index, source.start_index);
+		std::swap(top_index, source.top_index);
+		std::swap(total_size, source.total_size);
+		std::swap(total_capacity, source.total_capacity);
+		std::swap(min_block_capacity, source.min_block_capacity);
+		std::swap(max_block_capacity, source.max_block_capacity);
+	}
+}; // soa_queue
+
+
+} // plf namespace
+
+
+
+namespace std
+{
+
+template <class... field_types>
+void swap (plf::soa_queue<field_types...> &a, plf::soa_queue<field_types...> &b) PLF_NOEXCEPT
+{
+	a.swap(b);
+}
+
+}
+
+
+#endif // PLF_VARIADICS_SUPPORT && PLF_MOVE_SEMANTICS_SUPPORT && PLF_TYPE_TRAITS_SUPPORT
+
+
+
+#ifdef PLF_SOA_QUEUE_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_SOA_QUEUE_H
@@ -0,0 +1,186 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+#include <string>
+
+#include "plf_soa_queue.h"
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+	struct field_sum
+	{
+		unsigned int total, segments;
+
+		field_sum():
+			total(0),
+			segments(0)
+		{}
+
+		void operator () (const unsigned int *first, const unsigned int *last)
+		{
+			++segments;
+
+			for (; first != last; ++first)
+			{
+				total += *first;
+			}
+		}
+	};
+#endif
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+		unsigned int looper = 0;
+
+		while (++looper != 50)
+		{
+			{
+				title1("Test basics");
+
+				soa_queue<unsigned int, double, char> s_queue;
+
+				for (unsigned int temp = 0; temp != 25000; ++temp)
+				{
+					s_queue.push(temp, static_cast<double>(temp) * 2, static_cast<char>(temp & 127));
+				}
+
+				failpass("Multipush test", s_queue.size() == 25000 && s_queue.capacity() >= 25000);
+				failpass("Front test", s_queue.front<0>() == 0 && get<1>(s_queue.front()) == 0.0);
+				failpass("Back test", s_queue.back<0>() == 24999 && s_queue.back<1>() == 49998.0 && s_queue.back<2>() == static_cast<char>(24999 & 127));
+
+				soa_queue<unsigned int, double, char> s_queue2(s_queue);
+
+				failpass("Copy constructor test", s_queue2.size() == 25000 && s_queue2.back<1>() == 49998.0);
+
+				unsigned int total = 0;
+				bool fields_match = true;
+
+				for (unsigned int temp = 0; temp != 20000; ++temp)
+				{
+					total += s_queue.front<0>();
+					fields_match = fields_match && (s_queue.front<1>() == static_cast<double>(s_queue.front<0>()) * 2);
+					s_queue.pop();
+				}
+
+				failpass("Multipop test", s_queue.size() == 5000 && fields_match && total == (19999u * 20000u) / 2);
+
+				const field_sum sum = s_queue.for_each_segment<0>(field_sum());
+				unsigned int remaining_total = 0;
+
+				for (unsigned int temp = 20000; temp != 25000; ++temp)
+				{
+					remaining_total += temp;
+				}
+
+				failpass("Segment scan test", sum.total == remaining_total && sum.segments >= 1);
+
+				soa_queue<unsigned int, double, char> s_queue3(std::move(s_queue2));
+
+				failpass("Move constructor test", s_queue3.size() == 25000 && s_queue2.empty());
+
+				s_queue2 = s_queue3;
+				s_queue3.clear();
+
+				failpass("Copy assignment test", s_queue2.size() == 25000 && s_queue3.empty());
+
+				s_queue3.swap(s_queue2);
+
+				failpass("Swap test", s_queue3.size() == 25000 && s_queue2.empty());
+
+				do
+				{
+					if ((rand() & 3) == 0)
+					{
+						s_queue3.push(std::make_tuple(10u, 20.0, 'a'));
+					}
+					else
+					{
+						s_queue3.pop();
+					}
+				} while (!s_queue3.empty());
+
+				failpass("Randomly pop/push till empty test", s_queue3.empty() && s_queue3.capacity() != 0);
+
+				s_queue3.trim();
+				s_queue3.reserve(10000);
+
+				failpass("Reserve test", s_queue3.capacity() >= 10000);
+			}
+
+
+			{
+				title2("Non-trivial field tests");
+
+				soa_queue<string, int> str_queue(10, 100);
+
+				for (int temp = 0; temp != 1000; ++temp)
+				{
+					str_queue.push("a fairly long string to avoid small-string optimisation", temp);
+				}
+
+				int total = 0;
+
+				while (!str_queue.empty())
+				{
+					total += str_queue.front<0>().size() == 55 ? str_queue.front<1>() : -1000000;
+					str_queue.pop();
+				}
+
+				failpass("String field test", total == (999 * 1000) / 2);
+
+				for (int temp = 0; temp != 500; ++temp)
+				{
+					str_queue.push(string("abc"), temp);
+				}
+
+				failpass("Memory test", str_queue.memory() > str_queue.capacity() * (sizeof(string) + sizeof(int)));
+			}
+		}
+	#endif
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
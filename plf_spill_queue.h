@@ -0,0 +1,792 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_SPILL_QUEUE_H
+#define PLF_SPILL_QUEUE_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_SPILL_QUEUE_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <cstdio> // std::tmpfile, std::fclose
+#include <future> // std::async, std::future
+#include <limits>  // std::numeric_limits
+#include <new> // placement new, operator new
+#include <stdexcept> // std::length_error, std::runtime_error
+#include <type_traits> // std::is_trivially_copyable
+#include <utility> // std::forward, std::swap
+#include <vector> // free file slots
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	#define PLF_SPILL_QUEUE_POSIX
+	#include <sys/types.h> // off_t
+	#include <unistd.h> // pread, pwrite
+#endif
+
+
+
+namespace plf
+{
+
+
+// plf::spill_queue is a FIFO queue for trivially copyable types which caps it's resident memory: once the element blocks in memory exceed memory_limit bytes, full groups in the middle of the queue (never first_group, the group after it, or current_group) are written to an unnamed temporary file with a single write per group, and their blocks freed.
+// When pop() moves into a new front group, the group after it is read back from the file asynchronously, so it is usually resident again by the time pop() reaches it. push() and pop() only touch resident groups.
+// Group chain, growth and group recycling behaviour otherwise matches plf::queue. Spilling requires POSIX pread/pwrite; on other platforms memory_limit is ignored.
+
+template <class element_type>
+class spill_queue
+{
+public:
+	typedef element_type			value_type;
+	typedef std::size_t			size_type;
+	typedef element_type &		reference;
+	typedef const element_type &	const_reference;
+
+private:
+	static_assert(std::is_trivially_copyable<element_type>::value, "plf::spill_queue requires a trivially copyable element type");
+
+	#ifdef PLF_SPILL_QUEUE_POSIX
+		typedef off_t file_offset_type;
+	#else
+		typedef long long file_offset_type;
+	#endif
+
+	struct group
+	{
+		group					*next_group, *previous_group;
+		element_type			*elements; // NULL while spilled and not yet being read back
+		const size_type		capacity;
+		file_offset_type		file_offset;
+		std::future<bool>	loading; // valid while an asynchronous read back is in progress
+		bool						spilled;
+
+		group(const size_type elements_capacity, group * const previous) PLF_NOEXCEPT:
+			next_group(NULL),
+			previous_group(previous),
+			elements(NULL),
+			capacity(elements_capacity),
+			file_offset(0),
+			spilled(false)
+		{}
+	};
+
+
+	struct file_slot
+	{
+		file_offset_type	offset;
+		size_type			bytes;
+	};
+
+
+	group					*current_group, *first_group;
+	element_type		*top_element, *start_element; // top_element is one-past the back element
+	size_type			total_size, total_capacity, min_block_capacity, max_block_capacity;
+	size_type			resident_bytes, spill_limit, spilled_group_count;
+	std::FILE			*spill_file; // opened on first spill
+	file_offset_type	file_end;
+	std::vector<file_slot>	free_slots;
+
+
+
+	void check_capacities_conformance(const size_type min, const size_type max) const
+	{
+		if (min < 2 || min > max || max > (std::numeric_limits<size_type>::max() / (sizeof(element_type) * 2)))
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				throw std::length_error("Supplied memory block capacities outside of allowable ranges");
+			#else
+				std::terminate();
+			#endif
+		}
+	}
+
+
+
+	static void throw_read_failure()
+	{
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			throw std::runtime_error("plf::spill_queue: failed to read a spilled group back from the spill file");
+		#else
+			std::terminate();
+		#endif
+	}
+
+
+
+	element_type * allocate_elements(const size_type capacity)
+	{
+		element_type * const elements = static_cast<element_type *>(::operator new(capacity * sizeof(element_type)));
+		resident_bytes += capacity * sizeof(element_type);
+		return elements;
+	}
+
+
+
+	void deallocate_elements(group * const the_group) PLF_NOEXCEPT
+	{
+		if (the_group->elements != NULL)
+		{
+			::operator delete(static_cast<void *>(the_group->elements));
+			the_group->elements = NULL;
+			resident_bytes -= the_group->capacity * sizeof(element_type);
+		}
+	}
+
+
+
+	group * allocate_group(const size_type capacity, group * const previous)
+	{
+		group * const new_group = new group(capacity, previous);
+
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			try
+			{
+				new_group->elements = allocate_elements(capacity);
+			}
+			catch (...)
+			{
+				delete new_group;
+				throw;
+			}
+		#else
+			new_group->elements = allocate_elements(capacity);
+		#endif
+
+		total_capacity += capacity;
+		return new_group;
+	}
+
+
+
+	void deallocate_group(group * const the_group) PLF_NOEXCEPT
+	{
+		if (the_group->loading.valid()) the_group->loading.wait(); // the read back must not write into a freed block
+
+		if (the_group->spilled)
+		{
+			release_file_slot(the_group);
+		}
+
+		deallocate_elements(the_group);
+		total_capacity -= the_group->capacity;
+		delete the_group;
+	}
+
+
+
+	void initialize()
+	{
+		first_group = current_group = allocate_group(min_block_capacity, NULL);
+		start_element = top_element = first_group->elements;
+	}
+
+
+
+	void progress_to_next_group()
+	{
+		if (current_group->next_group == NULL) // no reserved groups or groups left over from previous pops, allocate new group
+		{
+			// Same logic as plf::queue - see plf_queue.h:
+			const size_type divided_size = total_size / plf::memory_use;
+			const size_type new_group_capacity = ((divided_size < (current_group->capacity * 2)) & (divided_size > (current_group->capacity / 2))) ? current_group->capacity :
+															(divided_size < min_block_capacity) ? min_block_capacity :
+															(divided_size > max_block_capacity) ? max_block_capacity : divided_size;
+
+			current_group->next_group = allocate_group(new_group_capacity, current_group);
+		}
+
+		current_group = current_group->next_group;
+		top_element = current_group->elements;
+
+		if (resident_bytes > spill_limit)
+		{
+			spill_middle_groups();
+		}
+	}
+
+
+
+	// Spill the most recently filled groups first, since they will be the last to be popped. Stops at the first group which is already spilled, as all groups before it were spilled earlier:
+	void spill_middle_groups() PLF_NOEXCEPT
+	{
+		for (group *current = current_group->previous_group; resident_bytes > spill_limit && current != first_group && current != first_group->next_group && !current->spilled; current = current->previous_group)
+		{
+			if (!spill_group(current)) return;
+		}
+	}
+
+
+
+	bool spill_group(group * const the_group) PLF_NOEXCEPT
+	{
+		#ifdef PLF_SPILL_QUEUE_POSIX
+			if (spill_file == NULL && (spill_file = std::tmpfile()) == NULL)
+			{
+				return false;
+			}
+
+			const size_type bytes = the_group->capacity * sizeof(element_type);
+			const file_offset_type offset = acquire_file_slot(bytes);
+
+			if (!transfer(true, fileno(spill_file), reinterpret_cast<char *>(the_group->elements), bytes, offset)) // eg. disk full - leave the group resident
+			{
+				add_free_slot(offset, bytes);
+				return false;
+			}
+
+			the_group->file_offset = offset;
+			the_group->spilled = true;
+			deallocate_elements(the_group);
+			++spilled_group_count;
+			return true;
+		#else
+			static_cast<void>(the_group);
+			return false;
+		#endif
+	}
+
+
+
+	#ifdef PLF_SPILL_QUEUE_POSIX
+		static bool transfer(const bool write, const int file_descriptor, char *buffer, size_type bytes, file_offset_type offset) PLF_NOEXCEPT
+		{
+			while (bytes != 0)
+			{
+				const ssize_t result = (write) ? ::pwrite(file_descriptor, buffer, bytes, offset) : ::pread(file_descriptor, buffer, bytes, offset);
+
+				if (result <= 0) return false;
+
+				buffer += result;
+				bytes -= static_cast<size_type>(result);
+				offset += result;
+			}
+
+			return true;
+		}
+	#endif
+
+
+
+	file_offset_type acquire_file_slot(const size_type bytes)
+	{
+		for (typename std::vector<file_slot>::iterator current = free_slots.begin(); current != free_slots.end(); ++current)
+		{
+			if (current->bytes == bytes)
+			{
+				const file_offset_type offset = current->offset;
+				*current = free_slots.back();
+				free_slots.pop_back();
+				return offset;
+			}
+		}
+
+		const file_offset_type offset = file_end;
+		file_end += static_cast<file_offset_type>(bytes);
+		return offset;
+	}
+
+
+
+	void release_file_slot(group * const the_group) PLF_NOEXCEPT
+	{
+		the_group->spilled = false;
+
+		if (--spilled_group_count == 0) // Nothing left in the file, start again from the beginning
+		{
+			free_slots.clear();
+			file_end = 0;
+			return;
+		}
+
+		add_free_slot(the_group->file_offset, the_group->capacity * sizeof(element_type));
+	}
+
+
+
+	void add_free_slot(const file_offset_type offset, const size_type bytes) PLF_NOEXCEPT
+	{
+		const file_slot slot = {offset, bytes};
+
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			try
+			{
+				free_slots.push_back(slot);
+			}
+			catch (...) // Losing the slot only wastes file space
+			{}
+		#else
+			free_slots.push_back(slot);
+		#endif
+	}
+
+
+
+	// Begin reading a spilled group back asynchronously into a newly-allocated block. This is only a prefetch, so if either the allocation or starting the read fails, the group is simply left spilled with no block, and make_resident() reads it synchronously later:
+	void start_load(group * const the_group) PLF_NOEXCEPT
+	{
+		#ifdef PLF_SPILL_QUEUE_POSIX
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				try
+				{
+					the_group->elements = allocate_elements(the_group->capacity);
+					the_group->loading = std::async(std::launch::async, &transfer, false, fileno(spill_file), reinterpret_cast<char *>(the_group->elements), the_group->capacity * sizeof(element_type), the_group->file_offset);
+				}
+				catch (...) // eg. std::system_error if a thread could not be started
+				{
+					deallocate_elements(the_group);
+				}
+			#else
+				the_group->elements = allocate_elements(the_group->capacity);
+				the_group->loading = std::async(std::launch::async, &transfer, false, fileno(spill_file), reinterpret_cast<char *>(the_group->elements), the_group->capacity * sizeof(element_type), the_group->file_offset);
+			#endif
+		#else
+			static_cast<void>(the_group);
+		#endif
+	}
+
+
+
+	void make_resident(group * const the_group)
+	{
+		if (!the_group->spilled) return;
+
+		#ifdef PLF_SPILL_QUEUE_POSIX
+			bool read_succeeded;
+
+			if (the_group->elements != NULL) // read ahead is in progress or complete
+			{
+				read_succeeded = the_group->loading.get();
+			}
+			else
+			{
+				the_group->elements = allocate_elements(the_group->capacity);
+				read_succeeded = transfer(false, fileno(spill_file), reinterpret_cast<char *>(the_group->elements), the_group->capacity * sizeof(element_type), the_group->file_offset);
+			}
+
+			if (!read_succeeded)
+			{
+				deallocate_elements(the_group); // so that a subsequent pop() retries the read
+				throw_read_failure();
+			}
+
+			release_file_slot(the_group);
+		#endif
+	}
+
+
+
+	void read_ahead(group * const the_group) PLF_NOEXCEPT
+	{
+		if (the_group != NULL && the_group->spilled && the_group->elements == NULL)
+		{
+			start_load(the_group);
+		}
+	}
+
+
+
+	void destroy_all_data() PLF_NOEXCEPT
+	{
+		while (first_group != NULL)
+		{
+			group * const next_group = first_group->next_group;
+			deallocate_group(first_group);
+			first_group = next_group;
+		}
+
+		if (spill_file != NULL)
+		{
+			std::fclose(spill_file);
+		}
+
+		blank();
+	}
+
+
+
+	void blank() PLF_NOEXCEPT
+	{
+		current_group = first_group = NULL;
+		top_element = start_element = NULL;
+		total_size = total_capacity = resident_bytes = spilled_group_count = 0;
+		spill_file = NULL;
+		file_end = 0;
+		free_slots.clear();
+	}
+
+
+
+public:
+
+	static PLF_CONSTFUNC size_type default_min_block_capacity() PLF_NOEXCEPT
+	{
+		return ((sizeof(element_type) * 8 > (sizeof(spill_queue) + sizeof(group)) * 2) ? 8 : (((sizeof(spill_queue) + sizeof(group)) * 2) / sizeof(element_type)) + 1) / plf::memory_use;
+	}
+
+
+
+	// Larger than plf::queue's default, so that each spill is a reasonably-sized write:
+	static PLF_CONSTFUNC size_type default_max_block_capacity() PLF_NOEXCEPT
+	{
+		return (sizeof(element_type) > 1024) ? 64 : 65536 / sizeof(element_type);
+	}
+
+
+
+	// memory_limit is the number of bytes of element blocks which may be resident before middle groups are spilled:
+	explicit spill_queue(const size_type memory_limit = std::numeric_limits<size_type>::max()):
+		current_group(NULL),
+		first_group(NULL),
+		top_element(NULL),
+		start_element(NULL),
+		total_size(0),
+		total_capacity(0),
+		min_block_capacity(default_min_block_capacity()),
+		max_block_capacity(default_max_block_capacity()),
+		resident_bytes(0),
+		spill_limit(memory_limit),
+		spilled_group_count(0),
+		spill_file(NULL),
+		file_end(0)
+	{}
+
+
+
+	spill_queue(const size_type memory_limit, const size_type min, const size_type max = default_max_block_capacity()):
+		current_group(NULL),
+		first_group(NULL),
+		top_element(NULL),
+		start_element(NULL),
+		total_size(0),
+		total_capacity(0),
+		min_block_capacity(min),
+		max_block_capacity(max),
+		resident_bytes(0),
+		spill_limit(memory_limit),
+		spilled_group_count(0),
+		spill_file(NULL),
+		file_end(0)
+	{
+		check_capacities_conformance(min, max);
+	}
+
+
+
+	spill_queue(const spill_queue &source) = delete; // Each queue owns it's spill file
+	spill_queue & operator = (const spill_queue &source) = delete;
+
+
+
+	spill_queue(spill_queue &&source) PLF_NOEXCEPT:
+		current_group(NULL),
+		first_group(NULL),
+		top_element(NULL),
+		start_element(NULL),
+		total_size(0),
+		total_capacity(0),
+		min_block_capacity(source.min_block_capacity),
+		max_block_capacity(source.max_block_capacity),
+		resident_bytes(0),
+		spill_limit(source.spill_limit),
+		spilled_group_count(0),
+		spill_file(NULL),
+		file_end(0)
+	{
+		swap(source);
+	}
+
+
+
+	spill_queue & operator = (spill_queue &&source) PLF_NOEXCEPT
+	{
+		assert(&source != this);
+
+		destroy_all_data();
+		swap(source);
+		return *this;
+	}
+
+
+
+	~spill_queue() PLF_NOEXCEPT
+	{
+		destroy_all_data();
+	}
+
+
+
+	void push(const element_type &element)
+	{
+		if (current_group == NULL)
+		{
+			initialize();
+		}
+		else if (top_element == current_group->elements + current_group->capacity)
+		{
+			progress_to_next_group();
+		}
+
+		::new (static_cast<void *>(top_element++)) element_type(element);
+		++total_size;
+	}
+
+
+
+	template<typename... arguments>
+	void emplace(arguments &&... parameters)
+	{
+		push(element_type(std::forward<arguments>(parameters)...));
+	}
+
+
+
+	reference front() PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+		return *start_element;
+	}
+
+
+
+	const_reference front() const PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+		return *start_element;
+	}
+
+
+
+	reference back() PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+		return *(top_element - 1);
+	}
+
+
+
+	const_reference back() const PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+		return *(top_element - 1);
+	}
+
+
+
+	// May block on, or throw from, reading the next group back if it was spilled and it's read ahead has not completed:
+	void pop()
+	{
+		assert(total_size != 0);
+
+		if (total_size != 1 && start_element + 1 == first_group->elements + first_group->capacity)
+		{
+			make_resident(first_group->next_group); // done first, so that a failed read leaves the queue unchanged
+		}
+
+		if (--total_size == 0)
+		{
+			start_element = top_element = first_group->elements;
+		}
+		else if (++start_element == first_group->elements + first_group->capacity) // ie. was the last element in first_group, so first_group != current_group
+		{
+			group * const next_group = first_group->next_group;
+
+			if (current_group->next_group == NULL && first_group->capacity == current_group->capacity)
+			{
+				current_group->next_group = first_group;
+				first_group->previous_group = current_group;
+				first_group->next_group = NULL;
+			}
+			else
+			{
+				deallocate_group(first_group);
+			}
+
+			first_group = next_group;
+			first_group->previous_group = NULL;
+			start_element = first_group->elements;
+			read_ahead(first_group->next_group);
+		}
+	}
+
+
+
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() const PLF_NOEXCEPT
+	{
+		return total_size == 0;
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return total_size;
+	}
+
+
+
+	size_type capacity() const PLF_NOEXCEPT
+	{
+		return total_capacity;
+	}
+
+
+
+	// Resident memory only - see spilled_memory():
+	size_type memory() const PLF_NOEXCEPT
+	{
+		size_type memory_use = sizeof(*this) + resident_bytes + (free_slots.capacity() * sizeof(file_slot));
+
+		for (const group *current = first_group; current != NULL; current = current->next_group)
+		{
+			memory_use += sizeof(group);
+		}
+
+		return memory_use;
+	}
+
+
+
+	size_type spilled_memory() const PLF_NOEXCEPT
+	{
+		size_type spilled_bytes = 0;
+
+		for (const group *current = first_group; current != NULL; current = current->next_group)
+		{
+			if (current->spilled && current->elements == NULL) spilled_bytes += current->capacity * sizeof(element_type);
+		}
+
+		return spilled_bytes;
+	}
+
+
+
+	size_type spilled_groups() const PLF_NOEXCEPT
+	{
+		return spilled_group_count;
+	}
+
+
+
+	size_type memory_limit() const PLF_NOEXCEPT
+	{
+		return spill_limit;
+	}
+
+
+
+	// Takes effect at the next group boundary during push:
+	void set_memory_limit(const size_type memory_limit) PLF_NOEXCEPT
+	{
+		spill_limit = memory_limit;
+	}
+
+
+
+	void reshape(const size_type min, const size_type max)
+	{
+		check_capacities_conformance(min, max);
+		min_block_capacity = min;
+		max_block_capacity = max;
+	}
+
+
+
+	void clear() PLF_NOEXCEPT
+	{
+		destroy_all_data();
+	}
+
+
+
+	// Remove trailing groups (as may be created by pop)
+	void trim() PLF_NOEXCEPT
+	{
+		if (current_group == NULL) return;
+
+		group *temp_group = current_group->next_group;
+		current_group->next_group = NULL;
+
+		while (temp_group != NULL)
+		{
+			group * const next_group = temp_group->next_group;
+			deallocate_group(temp_group);
+			temp_group = next_group;
+		}
+	}
+
+
+
+	void swap(spill_queue &source) PLF_NOEXCEPT
+	{
+		std::swap(current_group, source.current_group);
+		std::swap(first_group, source.first_group);
+		std::swap(top_element, source.top_element);
+		std::swap(start_element, source.start_element);
+		std::swap(total_size, source.total_size);
+		std::swap(total_capacity, source.total_capacity);
+		std::swap(min_block_capacity, source.min_block_capacity);
+		std::swap(max_block_capacity, source.max_block_capacity);
+		std::swap(resident_bytes, source.resident_bytes);
+		std::swap(spill_limit, source.spill_limit);
+		std::swap(spilled_group_count, source.spilled_group_count);
+		std::swap(spill_file, source.spill_file);
+		std::swap(file_end, source.file_end);
+		free_slots.swap(source.free_slots);
+	}
+}; // spill_queue
+
+
+} // plf namespace
+
+
+
+namespace std
+{
+
+template <class element_type>
+void swap (plf::spill_queue<element_type> &a, plf::spill_queue<element_type> &b) PLF_NOEXCEPT
+{
+	a.swap(b);
+}
+
+}
+
+
+#endif // PLF_VARIADICS_SUPPORT etc
+
+
+#undef PLF_SPILL_QUEUE_POSIX
+
+#ifdef PLF_SPILL_QUEUE_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_SPILL_QUEUE_H
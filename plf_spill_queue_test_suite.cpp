@@ -0,0 +1,189 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+
+#include "plf_spill_queue.h"
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+	struct record
+	{
+		unsigned int sequence;
+		double values[7];
+	};
+#endif
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+		unsigned int looper = 0;
+
+		while (++looper != 10)
+		{
+			{
+				title1("Test basics");
+
+				spill_queue<int> s_queue;
+
+				failpass("Empty test", s_queue.empty());
+
+				for (int temp = 0; temp != 100000; ++temp)
+				{
+					s_queue.push(temp);
+				}
+
+				failpass("Size test", s_queue.size() == 100000);
+				failpass("Front/back test", s_queue.front() == 0 && s_queue.back() == 99999);
+				failpass("Unlimited memory test", s_queue.spilled_groups() == 0);
+
+				int total = 0;
+
+				while (!s_queue.empty())
+				{
+					total += s_queue.front() & 1;
+					s_queue.pop();
+				}
+
+				failpass("Pop test", total == 50000);
+			}
+
+			{
+				title2("Spill tests");
+
+				const std::size_t memory_limit = 64 * 1024;
+				spill_queue<record> s_queue(memory_limit, 64, 256);
+				bool memory_capped = true;
+
+				for (unsigned int temp = 0; temp != 50000; ++temp)
+				{
+					record new_record = {temp, {temp * 0.5, 1, 2, 3, 4, 5, temp * 2.0}};
+					s_queue.push(new_record);
+
+					if (s_queue.memory() > memory_limit + (256 * sizeof(record)) + 32 * 1024) // ie. limit plus one group, plus group headers
+					{
+						memory_capped = false;
+					}
+				}
+
+				failpass("Spilled test", s_queue.spilled_groups() > 0 && s_queue.spilled_memory() > 0);
+				failpass("Resident memory test", memory_capped && s_queue.memory() < s_queue.size() * sizeof(record) / 4);
+				failpass("Front/back test", s_queue.front().sequence == 0 && s_queue.back().sequence == 49999);
+
+				bool contents_correct = true;
+
+				for (unsigned int temp = 0; temp != 30000; ++temp)
+				{
+					if (s_queue.front().sequence != temp || s_queue.front().values[6] != temp * 2.0)
+					{
+						contents_correct = false;
+					}
+
+					s_queue.pop();
+				}
+
+				failpass("Partial read back test", contents_correct);
+
+				for (unsigned int temp = 50000; temp != 70000; ++temp)
+				{
+					record new_record = {temp, {temp * 0.5, 1, 2, 3, 4, 5, temp * 2.0}};
+					s_queue.push(new_record);
+				}
+
+				for (unsigned int temp = 30000; temp != 70000; ++temp)
+				{
+					if (s_queue.front().sequence != temp || s_queue.front().values[0] != temp * 0.5)
+					{
+						contents_correct = false;
+					}
+
+					s_queue.pop();
+				}
+
+				failpass("Full read back test", contents_correct && s_queue.empty() && s_queue.spilled_groups() == 0);
+			}
+
+			{
+				title2("Move, swap and clear tests");
+
+				spill_queue<unsigned int> s_queue(4096, 64, 64);
+
+				for (unsigned int temp = 0; temp != 10000; ++temp)
+				{
+					s_queue.push(temp);
+				}
+
+				spill_queue<unsigned int> s_queue2(std::move(s_queue));
+
+				failpass("Move test", s_queue.empty() && s_queue2.size() == 10000 && s_queue2.spilled_groups() != 0);
+
+				s_queue.swap(s_queue2);
+
+				failpass("Swap test", s_queue2.empty() && s_queue.size() == 10000);
+
+				unsigned int expected = 0;
+				bool contents_correct = true;
+
+				for (; expected != 5000; ++expected)
+				{
+					contents_correct = contents_correct && s_queue.front() == expected;
+					s_queue.pop();
+				}
+
+				failpass("Post-swap contents test", contents_correct);
+
+				s_queue.clear();
+
+				failpass("Clear test", s_queue.empty() && s_queue.spilled_groups() == 0 && s_queue.capacity() == 0);
+
+				s_queue.emplace(5u);
+
+				failpass("Post-clear push test", s_queue.front() == 5 && s_queue.size() == 1);
+			}
+		}
+	#endif
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
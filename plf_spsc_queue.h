@@ -0,0 +1,355 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_SPSC_QUEUE_H
+#define PLF_SPSC_QUEUE_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_SPSC_QUEUE_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT) && defined(PLF_ALIGNMENT_SUPPORT)
+
+#include <atomic> // std::atomic
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <utility> // std::forward
+
+#include "plf_queue.h"
+#include "plf_queue_allocators.h" // plf::aligned_allocator
+
+
+
+namespace plf
+{
+
+
+// plf::spsc_queue is a lock-free single-producer, single-consumer queue which hands elements over a whole group at a time.
+// The producer fills a block (a plf::queue holding a single group) privately, with no atomic operations. When the group is full - ie. where plf::queue would otherwise progress to the next group - or when flush() is called, the block is linked onto the consumer-visible chain with a single release store. The consumer pops from the blocks it has received, and hands each drained block back to the producer through a lock-free return list, from which the producer reuses it. Concurrency overhead is therefore about one atomic operation per block in each direction, rather than one per element.
+// Elements pushed since the last handoff are not visible to the consumer until their block fills or flush() is called. A flushed block is not written to again, so frequent flushing trades memory reuse for latency.
+// Before C++17 element_type must be copy-constructible, as for plf::queue.
+
+template <class element_type, plf::priority priority = plf::memory_use>
+class spsc_queue
+{
+public:
+	typedef element_type	value_type;
+	typedef std::size_t	size_type;
+
+private:
+	struct alignas(64) block
+	{
+		plf::queue<element_type, priority>	elements;
+		std::atomic<block *>						next; // published chain
+		block											*next_free; // return and free lists
+
+		explicit block(const size_type capacity):
+			elements(capacity, capacity),
+			next(nullptr),
+			next_free(nullptr)
+		{}
+	};
+
+	typedef plf::aligned_allocator<block, 64> block_allocator_type;
+
+	// Producer-side and consumer-side members are kept on separate cache lines:
+	alignas(64) block		*tail; // producer-only: last block published
+	block						*pending; // producer-only: block being filled, not yet published
+	block						*free_blocks; // producer-only
+	size_type				block_capacity;
+	alignas(64) block		*head; // consumer-only: block being read, always published
+	alignas(64) std::atomic<block *>	returned_blocks; // pushed by the consumer, taken wholesale by the producer
+
+
+
+	block * allocate_block()
+	{
+		block_allocator_type allocator;
+		block * const new_block = allocator.allocate(1);
+
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			try
+			{
+				::new (static_cast<void *>(new_block)) block(block_capacity);
+			}
+			catch (...)
+			{
+				allocator.deallocate(new_block, 1);
+				throw;
+			}
+		#else
+			::new (static_cast<void *>(new_block)) block(block_capacity);
+		#endif
+
+		return new_block;
+	}
+
+
+
+	static void deallocate_block(block * const old_block) PLF_NOEXCEPT
+	{
+		block_allocator_type allocator;
+		old_block->~block();
+		allocator.deallocate(old_block, 1);
+	}
+
+
+
+	static void deallocate_list(block *current) PLF_NOEXCEPT
+	{
+		while (current != nullptr)
+		{
+			block * const next = current->next_free;
+			deallocate_block(current);
+			current = next;
+		}
+	}
+
+
+
+	// Producer-only. Reuse a block drained by the consumer if one is available, otherwise allocate:
+	block * obtain_block()
+	{
+		if (free_blocks == nullptr)
+		{
+			free_blocks = returned_blocks.exchange(nullptr, std::memory_order_acquire);
+
+			if (free_blocks == nullptr) return allocate_block();
+		}
+
+		block * const reused = free_blocks;
+		free_blocks = reused->next_free;
+		reused->next.store(nullptr, std::memory_order_relaxed);
+		return reused;
+	}
+
+
+
+	// Producer-only:
+	void publish() PLF_NOEXCEPT
+	{
+		tail->next.store(pending, std::memory_order_release);
+		tail = pending;
+		pending = nullptr;
+	}
+
+
+
+	// Producer-only. Called after every push, so that a block is published as soon as it's group is full:
+	void publish_if_full() PLF_NOEXCEPT
+	{
+		if (pending->elements.size() == pending->elements.capacity()) publish();
+	}
+
+
+
+	// Consumer-only:
+	void return_block(block * const drained) PLF_NOEXCEPT
+	{
+		drained->next_free = returned_blocks.load(std::memory_order_relaxed);
+
+		while (!returned_blocks.compare_exchange_weak(drained->next_free, drained, std::memory_order_release, std::memory_order_relaxed))
+		{}
+	}
+
+
+
+	// Consumer-only. Moves past drained blocks, returning false if no published element is available:
+	bool front_available() PLF_NOEXCEPT
+	{
+		while (head->elements.empty())
+		{
+			block * const next = head->next.load(std::memory_order_acquire);
+
+			if (next == nullptr) return false;
+
+			return_block(head); // head != tail, as next has been published, so the producer no longer references it
+			head = next;
+		}
+
+		return true;
+	}
+
+
+
+public:
+
+	// block_size is the minimum number of elements per handoff - the actual group capacity may be rounded up to suit the allocator:
+	explicit spsc_queue(const size_type block_size = 1024):
+		tail(nullptr),
+		pending(nullptr),
+		free_blocks(nullptr),
+		block_capacity(block_size),
+		head(nullptr),
+		returned_blocks(nullptr)
+	{
+		tail = head = allocate_block(); // empty sentinel, so that head and tail are never NULL
+	}
+
+
+
+	spsc_queue(const spsc_queue &source) = delete;
+	spsc_queue & operator = (const spsc_queue &source) = delete;
+
+
+
+	~spsc_queue()
+	{
+		for (block *current = head; current != nullptr;)
+		{
+			block * const next = current->next.load(std::memory_order_relaxed);
+			deallocate_block(current);
+			current = next;
+		}
+
+		if (pending != nullptr) deallocate_block(pending);
+
+		deallocate_list(free_blocks);
+		deallocate_list(returned_blocks.load(std::memory_order_relaxed));
+	}
+
+
+
+	// Producer-only:
+	void push(const element_type &element)
+	{
+		if (pending == nullptr) pending = obtain_block();
+
+		pending->elements.push(element);
+		publish_if_full();
+	}
+
+
+
+	// Producer-only:
+	void push(element_type &&element)
+	{
+		if (pending == nullptr) pending = obtain_block();
+
+		pending->elements.push(std::move(element));
+		publish_if_full();
+	}
+
+
+
+	// Producer-only:
+	template<typename... arguments>
+	void emplace(arguments &&... parameters)
+	{
+		if (pending == nullptr) pending = obtain_block();
+
+		pending->elements.emplace(std::forward<arguments>(parameters)...);
+		publish_if_full();
+	}
+
+
+
+	// Producer-only. Makes any elements pushed since the last handoff visible to the consumer:
+	void flush() PLF_NOEXCEPT
+	{
+		if (pending != nullptr && !pending->elements.empty()) publish();
+	}
+
+
+
+	// Consumer-only. Returns false if no published element is available:
+	bool try_pop(element_type &destination)
+	{
+		if (!front_available()) return false;
+
+		return head->elements.try_pop(destination);
+	}
+
+
+
+	// Consumer-only. The oldest published element. Exception may occur if there is none:
+	element_type & front()
+	{
+		const bool available = front_available();
+		assert(available);
+		static_cast<void>(available);
+		return head->elements.front();
+	}
+
+
+
+	// Consumer-only:
+	void pop() // Exception may occur if there is no published element
+	{
+		const bool available = front_available();
+		assert(available);
+		static_cast<void>(available);
+		head->elements.pop();
+	}
+
+
+
+	// Consumer-only. Calls function with each published element in turn, popping it afterwards, and returns the number consumed:
+	template <class function_type>
+	size_type consume_all(function_type function)
+	{
+		size_type count = 0;
+
+		while (front_available())
+		{
+			for (; !head->elements.empty(); head->elements.pop(), ++count)
+			{
+				function(head->elements.front());
+			}
+		}
+
+		return count;
+	}
+
+
+
+	// Consumer-only. True when no published element is available - elements the producer has not yet handed off are not seen:
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() PLF_NOEXCEPT
+	{
+		return !front_available();
+	}
+
+
+
+	size_type block_size() const PLF_NOEXCEPT
+	{
+		return block_capacity;
+	}
+}; // spsc_queue
+
+
+} // plf namespace
+
+
+#endif // PLF_VARIADICS_SUPPORT etc
+
+
+#ifdef PLF_SPSC_QUEUE_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_SPSC_QUEUE_H
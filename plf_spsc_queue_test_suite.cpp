@@ -0,0 +1,198 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+#include <string> // std::string elements
+
+#include "plf_spsc_queue.h"
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT) && defined(PLF_ALIGNMENT_SUPPORT)
+	#include <thread> // std::thread, std::this_thread::yield
+#endif
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT) && defined(PLF_ALIGNMENT_SUPPORT)
+	void produce(plf::spsc_queue<unsigned int> *s_queue, const unsigned int count, const unsigned int flush_interval)
+	{
+		for (unsigned int counter = 0; counter != count; ++counter)
+		{
+			s_queue->push(counter);
+
+			if (flush_interval != 0 && (counter % flush_interval) == 0) s_queue->flush();
+		}
+
+		s_queue->flush();
+	}
+#endif
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT) && defined(PLF_ALIGNMENT_SUPPORT)
+		unsigned int looper = 0;
+
+		while (++looper != 20)
+		{
+			{
+				title1("Test basics");
+
+				spsc_queue<int> s_queue(8);
+				int value = 0;
+
+				failpass("Empty test", s_queue.empty() && !s_queue.try_pop(value) && s_queue.block_size() == 8);
+
+				s_queue.push(1);
+				s_queue.push(2);
+
+				failpass("Unpublished elements not visible test", s_queue.empty() && !s_queue.try_pop(value));
+
+				s_queue.flush();
+
+				failpass("Flush test", !s_queue.empty() && s_queue.front() == 1);
+
+				s_queue.pop();
+
+				failpass("Pop test", s_queue.try_pop(value) && value == 2 && s_queue.empty());
+
+				s_queue.push(3);
+				s_queue.flush();
+				s_queue.flush();
+
+				failpass("Repeated flush test", s_queue.try_pop(value) && value == 3 && !s_queue.try_pop(value));
+
+				unsigned int pushed = 0;
+
+				while (s_queue.empty())
+				{
+					s_queue.emplace(static_cast<int>(pushed++));
+				}
+
+				failpass("Full group handoff test", pushed >= 8 && s_queue.front() == 0);
+
+				int total = 0, expected_total = 0;
+
+				for (unsigned int counter = 0; counter != pushed; ++counter)
+				{
+					expected_total += static_cast<int>(counter);
+				}
+
+				failpass("Consume all test", s_queue.consume_all([&total](const int element) { total += element; }) == pushed && total == expected_total && s_queue.empty());
+			}
+
+
+			{
+				title2("Non-trivial type tests");
+
+				spsc_queue<std::string> s_queue(16);
+				std::string value;
+				bool matches = true;
+				unsigned int popped = 0;
+
+				for (unsigned int counter = 0; counter != 5000; ++counter)
+				{
+					s_queue.push(std::string(counter % 40, 'a'));
+
+					if ((counter % 29) == 0) s_queue.flush();
+
+					if ((counter % 3) == 0)
+					{
+						while (s_queue.try_pop(value))
+						{
+							matches = matches && value == std::string(popped++ % 40, 'a');
+						}
+					}
+				}
+
+				s_queue.flush();
+
+				while (s_queue.try_pop(value))
+				{
+					matches = matches && value == std::string(popped++ % 40, 'a');
+				}
+
+				failpass("Order preserved across flushes test", matches && popped == 5000);
+
+				for (unsigned int counter = 0; counter != 100; ++counter)
+				{
+					s_queue.push(std::string(100, 'b'));
+				}
+
+				// Elements left in the queue, including an unpublished partial block, are destroyed by the destructor
+			}
+
+
+			{
+				title2("Producer/consumer thread tests");
+
+				for (unsigned int flush_interval = 0; flush_interval < 300; flush_interval += 97)
+				{
+					const unsigned int count = 200000;
+					spsc_queue<unsigned int> s_queue(64);
+					std::thread producer(produce, &s_queue, count, flush_interval);
+
+					unsigned int received = 0, value = 0;
+					bool in_order = true;
+
+					while (received != count && in_order)
+					{
+						if (s_queue.try_pop(value))
+						{
+							in_order = value == received++;
+						}
+						else
+						{
+							std::this_thread::yield();
+						}
+					}
+
+					producer.join();
+
+					failpass("Cross-thread FIFO test", in_order && received == count && s_queue.empty());
+				}
+			}
+		}
+	#endif
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
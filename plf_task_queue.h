@@ -0,0 +1,479 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_TASK_QUEUE_H
+#define PLF_TASK_QUEUE_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_TASK_QUEUE_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t, std::max_align_t
+#include <new> // placement new
+#include <type_traits> // std::decay
+#include <utility> // std::forward, std::swap
+
+#include "plf_queue_group_chain.h"
+
+
+
+namespace plf
+{
+
+
+// plf::task_queue is a FIFO queue of type-erased void() callables, stored inline in the group blocks alongside a small thunk header, so pushing a task does not allocate per task.
+// Callables larger than max_inline_size, or over-aligned callables, are stored on the heap and only a pointer to them is stored inline.
+// Group chain and group recycling behaviour matches plf::queue, though groups are always allocated with plain operator new and grow as per plf::memory_use (see plf::group_chain), with block capacities measured in bytes.
+// A running task may push further tasks onto it's own queue, but must not call run_one()/run_all() on it.
+
+class task_queue : private plf::group_chain<plf::byte_group<alignof(std::max_align_t)> >
+{
+public:
+	typedef std::size_t	size_type;
+
+	static const size_type max_inline_size = 256; // Callables larger than this are stored on the heap
+
+private:
+	typedef plf::byte_group<alignof(std::max_align_t)>	group; // entries start at the first max_align_t boundary after the group header
+	typedef plf::group_chain<group>							chain_type;
+
+	typedef void (*thunk_type)(void *storage, bool invoke); // Invokes (if invoke == true) then destroys the callable
+
+	struct entry_header
+	{
+		thunk_type	thunk;
+		size_type	footprint; // bytes used by this entry, including the header
+	};
+
+
+	static const size_type entry_alignment = alignof(std::max_align_t);
+	static const size_type header_size = (sizeof(entry_header) + (entry_alignment - 1)) & ~(entry_alignment - 1);
+
+	size_type		start_offset, top_offset; // offsets of the front entry within first_group, and one-past the back entry within current_group
+	size_type		total_bytes;
+
+
+
+	template <class callable_type>
+	struct stored_inline : std::integral_constant<bool, (sizeof(callable_type) <= max_inline_size && alignof(callable_type) <= entry_alignment)>
+	{};
+
+
+
+	template <class callable_type>
+	static void inline_thunk(void * const storage, const bool invoke)
+	{
+		callable_type &callable = *static_cast<callable_type *>(storage);
+
+		if (invoke)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				try
+				{
+					callable();
+				}
+				catch (...)
+				{
+					callable.~callable_type();
+					throw;
+				}
+			#else
+				callable();
+			#endif
+		}
+
+		callable.~callable_type();
+	}
+
+
+
+	template <class callable_type>
+	static void heap_thunk(void * const storage, const bool invoke)
+	{
+		callable_type * const callable = *static_cast<callable_type **>(storage);
+
+		if (invoke)
+		{
+			#ifdef PLF_EXCEPTIONS_SUPPORT
+				try
+				{
+					(*callable)();
+				}
+				catch (...)
+				{
+					delete callable;
+					throw;
+				}
+			#else
+				(*callable)();
+			#endif
+		}
+
+		delete callable;
+	}
+
+
+
+	void progress_to_next_group(const size_type footprint) // used by push when the entry does not fit in the current group
+	{
+		current_group->used = top_offset;
+		chain_type::progress_to_next_group(total_bytes, footprint);
+		current_group->used = 0;
+		top_offset = 0;
+	}
+
+
+
+	entry_header * front_entry() const PLF_NOEXCEPT
+	{
+		return reinterpret_cast<entry_header *>(first_group->data() + start_offset);
+	}
+
+
+
+	void advance_front(const size_type footprint) PLF_NOEXCEPT
+	{
+		total_bytes -= footprint;
+
+		if (--total_size == 0)
+		{
+			start_offset = top_offset = 0;
+		}
+		else if ((start_offset += footprint) == first_group->used && first_group != current_group)
+		{ // ie. was the last entry in first_group
+			retire_first_group();
+			start_offset = 0;
+		}
+	}
+
+
+
+	void destroy_all_data() PLF_NOEXCEPT
+	{
+		while (total_size != 0)
+		{
+			entry_header * const entry = front_entry();
+			entry->thunk(reinterpret_cast<unsigned char *>(entry) + header_size, false);
+			advance_front(entry->footprint);
+		}
+
+		deallocate_all_groups();
+		blank();
+	}
+
+
+
+	void blank() PLF_NOEXCEPT
+	{
+		current_group = first_group = NULL;
+		start_offset = top_offset = total_size = total_bytes = total_capacity = 0;
+	}
+
+
+
+public:
+
+	static PLF_CONSTFUNC size_type default_min_block_capacity() PLF_NOEXCEPT
+	{
+		return 1024;
+	}
+
+
+
+	static PLF_CONSTFUNC size_type default_max_block_capacity() PLF_NOEXCEPT
+	{
+		return 65536;
+	}
+
+
+
+	task_queue() PLF_NOEXCEPT:
+		chain_type(default_min_block_capacity(), default_max_block_capacity()),
+		start_offset(0),
+		top_offset(0),
+		total_bytes(0)
+	{}
+
+
+
+	// Constructor with limits, in bytes:
+	task_queue(const size_type min, const size_type max = default_max_block_capacity()):
+		chain_type(min, max),
+		start_offset(0),
+		top_offset(0),
+		total_bytes(0)
+	{
+		check_capacities_conformance(min, max, header_size * 2);
+	}
+
+
+
+	task_queue(const task_queue &source) = delete; // Callables are not required to be copyable
+	task_queue & operator = (const task_queue &source) = delete;
+
+
+
+	task_queue(task_queue &&source) PLF_NOEXCEPT:
+		chain_type(source.min_block_capacity, source.max_block_capacity),
+		start_offset(0),
+		top_offset(0),
+		total_bytes(0)
+	{
+		swap(source);
+	}
+
+
+
+	task_queue & operator = (task_queue &&source) PLF_NOEXCEPT
+	{
+		assert(&source != this);
+
+		destroy_all_data();
+		swap(source);
+		return *this;
+	}
+
+
+
+	~task_queue() PLF_NOEXCEPT
+	{
+		destroy_all_data();
+	}
+
+
+
+	template <class callable_type>
+	void push(callable_type &&callable)
+	{
+		typedef typename std::decay<callable_type>::type stored_type;
+
+		const size_type storage_size = (stored_inline<stored_type>::value) ? sizeof(stored_type) : sizeof(stored_type *);
+		const size_type footprint = header_size + ((storage_size + (entry_alignment - 1)) & ~(entry_alignment - 1));
+		group * const original_group = current_group;
+		const size_type original_top_offset = top_offset;
+
+		if (current_group == NULL)
+		{
+			initialize(footprint);
+		}
+		else if (current_group->capacity - top_offset < footprint)
+		{
+			progress_to_next_group(footprint);
+		}
+
+		unsigned char * const entry = current_group->data() + top_offset;
+
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			try
+			{
+		#endif
+				if PLF_CONSTEXPR (stored_inline<stored_type>::value)
+				{
+					::new (static_cast<void *>(entry + header_size)) stored_type(std::forward<callable_type>(callable));
+					::new (static_cast<void *>(entry)) entry_header {&inline_thunk<stored_type>, footprint};
+				}
+				else
+				{
+					*reinterpret_cast<stored_type **>(entry + header_size) = new stored_type(std::forward<callable_type>(callable));
+					::new (static_cast<void *>(entry)) entry_header {&heap_thunk<stored_type>, footprint};
+				}
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			}
+			catch (...)
+			{
+				if (total_size != 0 && current_group != original_group) // Return to the original group, leaving the new group as a reserved group
+				{
+					current_group = original_group;
+					top_offset = original_top_offset;
+				}
+
+				throw;
+			}
+		#endif
+
+		top_offset += footprint;
+		total_bytes += footprint;
+		++total_size;
+	}
+
+
+
+	template <class callable_type, class... arguments>
+	void emplace(arguments &&... parameters)
+	{
+		push(callable_type(std::forward<arguments>(parameters)...));
+	}
+
+
+
+	// Invokes and destroys the front task in a single pass. Returns false if the queue was empty:
+	bool run_one()
+	{
+		if (total_size == 0) return false;
+
+		entry_header * const entry = front_entry();
+		const size_type footprint = entry->footprint;
+
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			try
+			{
+				entry->thunk(reinterpret_cast<unsigned char *>(entry) + header_size, true);
+			}
+			catch (...) // the task is destroyed by the thunk and removed from the queue before rethrowing
+			{
+				advance_front(footprint);
+				throw;
+			}
+		#else
+			entry->thunk(reinterpret_cast<unsigned char *>(entry) + header_size, true);
+		#endif
+
+		advance_front(footprint);
+		return true;
+	}
+
+
+
+	// Runs tasks until the queue is empty, including any tasks pushed by the tasks being run. Returns the number of tasks run:
+	size_type run_all()
+	{
+		size_type count = 0;
+
+		while (run_one())
+		{
+			++count;
+		}
+
+		return count;
+	}
+
+
+
+	// Destroys the front task without invoking it:
+	void pop() PLF_NOEXCEPT
+	{
+		assert(total_size != 0);
+
+		entry_header * const entry = front_entry();
+		const size_type footprint = entry->footprint;
+		entry->thunk(reinterpret_cast<unsigned char *>(entry) + header_size, false);
+		advance_front(footprint);
+	}
+
+
+
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() const PLF_NOEXCEPT
+	{
+		return total_size == 0;
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return total_size;
+	}
+
+
+
+	// In bytes:
+	size_type capacity() const PLF_NOEXCEPT
+	{
+		return total_capacity;
+	}
+
+
+
+	size_type memory() const PLF_NOEXCEPT
+	{
+		return sizeof(*this) + groups_memory();
+	}
+
+
+
+	void reshape(const size_type min, const size_type max)
+	{
+		check_capacities_conformance(min, max, header_size * 2);
+		min_block_capacity = min;
+		max_block_capacity = max;
+	}
+
+
+
+	void clear() PLF_NOEXCEPT
+	{
+		destroy_all_data();
+	}
+
+
+
+	// Remove trailing groups (as may be created by reserve or pop)
+	using chain_type::trim;
+
+
+
+	// Reserve capacity in bytes:
+	using chain_type::reserve;
+
+
+
+	void swap(task_queue &source) PLF_NOEXCEPT
+	{
+		swap_chain(source);
+		std::swap(start_offset, source.start_offset);
+		std::swap(top_offset, source.top_offset);
+		std::swap(total_bytes, source.total_bytes);
+	}
+}; // task_queue
+
+
+} // plf namespace
+
+
+
+namespace std
+{
+
+inline void swap (plf::task_queue &a, plf::task_queue &b) PLF_NOEXCEPT
+{
+	a.swap(b);
+}
+
+}
+
+
+#endif // PLF_VARIADICS_SUPPORT etc
+
+
+#ifdef PLF_TASK_QUEUE_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_TASK_QUEUE_H
@@ -0,0 +1,243 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+#include <functional> // function
+#include <memory> // unique_ptr
+#include <stdexcept> // runtime_error
+
+#include "plf_task_queue.h"
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+	struct destruction_counter
+	{
+		int *destructions;
+
+		destruction_counter(int *counter):
+			destructions(counter)
+		{}
+
+		destruction_counter(destruction_counter &&source):
+			destructions(source.destructions)
+		{
+			source.destructions = NULL;
+		}
+
+		~destruction_counter()
+		{
+			if (destructions != NULL) ++*destructions;
+		}
+
+		void operator () () const
+		{}
+	};
+
+
+
+	struct large_task
+	{
+		int *total;
+		char padding[512];
+
+		void operator () () const
+		{
+			*total += padding[0] + padding[511];
+		}
+	};
+
+	struct move_only_task
+	{
+		int *total;
+		std::unique_ptr<int> value;
+
+		void operator () () const
+		{
+			*total += (*value > 0) ? 1 : 0;
+		}
+	};
+#endif
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+		unsigned int looper = 0;
+
+		while (++looper != 50)
+		{
+			{
+				title1("Test basics");
+
+				task_queue t_queue;
+				int total = 0;
+
+				failpass("Empty test", t_queue.empty() && !t_queue.run_one());
+
+				for (int temp = 0; temp != 1000; ++temp)
+				{
+					t_queue.push([&total, temp] () { total = (total * 3 + temp) % 1000003; });
+				}
+
+				failpass("Size test", t_queue.size() == 1000);
+
+				int expected = 0;
+
+				for (int temp = 0; temp != 1000; ++temp)
+				{
+					expected = (expected * 3 + temp) % 1000003;
+				}
+
+				failpass("Run one test", t_queue.run_one() && t_queue.size() == 999);
+				failpass("Run all test", t_queue.run_all() == 999 && t_queue.empty());
+				failpass("Order test", total == expected);
+			}
+
+			{
+				title2("Mixed size and heap spill tests");
+
+				task_queue t_queue(64, 512);
+				int total = 0;
+
+				for (int temp = 0; temp != 500; ++temp)
+				{
+					if (temp % 3 == 0)
+					{
+						large_task task;
+						task.total = &total;
+						task.padding[0] = 1;
+						task.padding[511] = 1;
+						t_queue.push(task);
+					}
+					else
+					{
+						move_only_task task;
+						task.total = &total;
+						task.value.reset(new int(temp));
+						t_queue.push(std::move(task));
+					}
+				}
+
+				t_queue.run_all();
+
+				failpass("Mixed total test", total == (167 * 2) + 333);
+			}
+
+			{
+				title2("Destruction tests");
+
+				int destructions = 0;
+
+				{
+					task_queue t_queue;
+
+					for (int temp = 0; temp != 100; ++temp)
+					{
+						t_queue.push(destruction_counter(&destructions));
+					}
+
+					t_queue.run_one();
+					t_queue.pop();
+
+					failpass("Run/pop destruction test", destructions == 2 && t_queue.size() == 98);
+
+					task_queue t_queue2(std::move(t_queue));
+
+					failpass("Move test", t_queue.empty() && t_queue2.size() == 98 && destructions == 2);
+				}
+
+				failpass("Destructor test", destructions == 100);
+			}
+
+			{
+				title2("Exception and re-entrant push tests");
+
+				task_queue t_queue;
+				int total = 0;
+
+				t_queue.push([] () { throw std::runtime_error("task failure"); });
+				t_queue.push([&total] () { ++total; });
+
+				bool thrown = false;
+
+				try
+				{
+					t_queue.run_one();
+				}
+				catch (std::runtime_error &)
+				{
+					thrown = true;
+				}
+
+				failpass("Exception test", thrown && t_queue.size() == 1);
+
+				t_queue.run_all();
+
+				failpass("Post-exception run test", total == 1 && t_queue.empty());
+
+				std::function<void()> spawn;
+				spawn = [&] () { if (++total != 1000) t_queue.push(spawn); };
+				t_queue.push(spawn);
+
+				failpass("Re-entrant push test", t_queue.run_all() == 999 && total == 1000);
+
+				t_queue.reserve(10000);
+				const std::size_t capacity = t_queue.capacity();
+
+				for (int temp = 0; temp != 200; ++temp)
+				{
+					t_queue.push([&total] () { ++total; });
+				}
+
+				failpass("Reserve test", capacity >= 10000 && t_queue.capacity() == capacity);
+
+				t_queue.clear();
+
+				failpass("Clear test", t_queue.empty() && t_queue.capacity() == 0 && total == 1000);
+			}
+		}
+	#endif
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
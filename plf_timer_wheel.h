@@ -0,0 +1,580 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_TIMER_WHEEL_H
+#define PLF_TIMER_WHEEL_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_TIMER_WHEEL_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <utility> // std::forward, std::move, std::swap
+#include <vector> // buckets, timer records
+
+#include "plf_queue.h"
+
+
+
+namespace plf
+{
+
+
+// plf::timer_wheel is a hierarchical timing wheel. Each of the 'levels' wheels has 2^slot_bits slots, and each slot is a plf::queue bucket of timer entries. Level n slots cover 2^(slot_bits * n) ticks each; deadlines beyond the top level's range wait in an overflow bucket.
+// schedule() is O(1): the entry is pushed onto the bucket of the lowest level whose range contains the deadline. cancel() is O(1): it invalidates the timer's handle, and the entry is discarded when it's bucket is next drained or cascaded.
+// advance(to, function) processes each tick up to and including 'to'. When a tick reaches the start of a higher-level slot, that bucket is swapped out and redistributed to the lower levels - if every entry belongs in the same, empty, lower bucket, the bucket's groups are swapped across whole rather than moved element by element. The level-0 bucket for the tick is then swapped out and drained front-to-back, calling function(value) for each timer still pending. Runs of ticks with nothing to process are skipped.
+// Compared to a binary heap (eg. std::priority_queue), schedule() and cancel() avoid the O(log n) sift, but each timer may be moved once per level it cascades through, and advance() costs at least one bucket check per tick with pending timers. Which is faster depends on the number of timers, their delay range and how far each advance() moves, so measure with your own workload.
+// As buckets are swapped using plf::queue::swap, element_type must be copy-constructible prior to C++17.
+
+template <class element_type, unsigned int slot_bits = 8, unsigned int levels = 4, plf::priority priority = plf::memory_use>
+class timer_wheel
+{
+public:
+	typedef element_type				value_type;
+	typedef std::size_t				size_type;
+	typedef unsigned long long		tick_type;
+
+	struct timer_handle
+	{
+		size_type	index, generation;
+
+		timer_handle() PLF_NOEXCEPT:
+			index(~static_cast<size_type>(0)),
+			generation(0)
+		{}
+
+		timer_handle(const size_type timer_index, const size_type timer_generation) PLF_NOEXCEPT:
+			index(timer_index),
+			generation(timer_generation)
+		{}
+	};
+
+private:
+	static_assert(slot_bits != 0 && levels != 0 && slot_bits * levels < sizeof(tick_type) * 8, "plf::timer_wheel slot_bits * levels must be less than 64");
+
+	static const size_type slot_count = static_cast<size_type>(1) << slot_bits;
+	static const tick_type slot_mask = (static_cast<tick_type>(1) << slot_bits) - 1;
+
+	struct entry
+	{
+		tick_type		deadline;
+		size_type		timer_index, generation;
+		element_type	value;
+
+		template<typename input_type>
+		entry(const tick_type entry_deadline, const size_type index, const size_type entry_generation, input_type &&entry_value):
+			deadline(entry_deadline),
+			timer_index(index),
+			generation(entry_generation),
+			value(std::forward<input_type>(entry_value))
+		{}
+	};
+
+	struct timer_record
+	{
+		size_type	generation;
+		bool			pending;
+	};
+
+	typedef plf::queue<entry, priority> bucket_type;
+
+
+	std::vector<bucket_type>	buckets; // levels * slot_count, level-major
+	bucket_type						overflow, spare; // spare is swapped with buckets as they are drained or cascaded, so their groups are recycled
+	std::vector<timer_record>	timers;
+	std::vector<size_type>		free_timers; // capacity is kept >= timers.size(), so releasing a timer never allocates
+	size_type						level_counts[levels + 1]; // entries stored at each level including cancelled ones, overflow last
+	size_type						active_count;
+	tick_type						current_time;
+
+
+
+	static PLF_CONSTFUNC tick_type level_shift(const unsigned int level) PLF_NOEXCEPT
+	{
+		return static_cast<tick_type>(slot_bits) * level;
+	}
+
+
+
+	// Lowest level whose current rotation contains the deadline, or 'levels' for the overflow bucket:
+	unsigned int level_of(const tick_type deadline) const PLF_NOEXCEPT
+	{
+		if (deadline <= current_time) return 0; // only occurs when cascading an entry due on the current tick
+
+		unsigned int level = 0;
+
+		while (level != levels && (deadline >> level_shift(level + 1)) != (current_time >> level_shift(level + 1)))
+		{
+			++level;
+		}
+
+		return level;
+	}
+
+
+
+	bucket_type & bucket_for(const unsigned int level, const tick_type deadline) PLF_NOEXCEPT
+	{
+		if (level == levels) return overflow;
+
+		const tick_type time = (deadline < current_time) ? current_time : deadline;
+		return buckets[(level * slot_count) + static_cast<size_type>((time >> level_shift(level)) & slot_mask)];
+	}
+
+
+
+	bool is_pending(const entry &the_entry) const PLF_NOEXCEPT
+	{
+		const timer_record &record = timers[the_entry.timer_index];
+		return record.pending && record.generation == the_entry.generation;
+	}
+
+
+
+	size_type acquire_timer()
+	{
+		if (free_timers.empty())
+		{
+			timer_record record = {0, false};
+			timers.push_back(record);
+			free_timers.reserve(timers.capacity());
+			return timers.size() - 1;
+		}
+
+		const size_type index = free_timers.back();
+		free_timers.pop_back();
+		return index;
+	}
+
+
+
+	void release_timer(const size_type index) PLF_NOEXCEPT
+	{
+		timers[index].pending = false;
+		++timers[index].generation;
+		free_timers.push_back(index);
+		--active_count;
+	}
+
+
+
+	size_type stored_count() const PLF_NOEXCEPT
+	{
+		size_type total = 0;
+
+		for (unsigned int level = 0; level != levels + 1; ++level)
+		{
+			total += level_counts[level];
+		}
+
+		return total;
+	}
+
+
+
+	// Redistribute a higher-level (or overflow) bucket's entries to the levels below it:
+	void cascade(bucket_type &source, const unsigned int source_level)
+	{
+		spare.swap(source);
+		level_counts[source_level] -= spare.size();
+
+		// If everything belongs in the same empty bucket, hand over the groups whole:
+		const unsigned int first_level = level_of(spare.front().deadline);
+		bucket_type &first_target = bucket_for(first_level, spare.front().deadline);
+
+		if (first_target.empty())
+		{
+			bool uniform = true;
+
+			typename bucket_type::const_iterator current = spare.cbegin();
+
+			for (size_type remaining = spare.size(); remaining != 0; --remaining, ++current) // counted rather than compared against cend(), as the bucket may have reserved groups after it's back element
+			{
+				const unsigned int level = level_of(current->deadline);
+
+				if (level != first_level || &bucket_for(level, current->deadline) != &first_target)
+				{
+					uniform = false;
+					break;
+				}
+			}
+
+			if (uniform)
+			{
+				first_target.swap(spare);
+				level_counts[first_level] += first_target.size();
+				return;
+			}
+		}
+
+		for (; !spare.empty(); spare.pop())
+		{
+			entry &current = spare.front();
+
+			if (is_pending(current))
+			{
+				const unsigned int level = level_of(current.deadline);
+				bucket_for(level, current.deadline).push(std::move(current));
+				++level_counts[level];
+			}
+		}
+	}
+
+
+
+	template <class function_type>
+	size_type drain(const tick_type tick, function_type &function)
+	{
+		bucket_type &bucket = buckets[static_cast<size_type>(tick & slot_mask)];
+
+		if (bucket.empty()) return 0;
+
+		spare.swap(bucket);
+		level_counts[0] -= spare.size();
+		size_type fired = 0;
+
+		for (; !spare.empty(); spare.pop())
+		{
+			entry &current = spare.front();
+
+			if (is_pending(current))
+			{
+				release_timer(current.timer_index);
+				++fired;
+
+				#ifdef PLF_EXCEPTIONS_SUPPORT
+					try
+					{
+						function(current.value);
+					}
+					catch (...)
+					{ // Put the unprocessed remainder back and rewind, so the next advance() resumes at this tick:
+						spare.pop();
+						bucket.swap(spare);
+						level_counts[0] += bucket.size();
+						current_time = tick - 1;
+						throw;
+					}
+				#else
+					function(current.value);
+				#endif
+			}
+		}
+
+		return fired;
+	}
+
+
+
+	void process_tick(const tick_type tick)
+	{
+		if ((tick & ((static_cast<tick_type>(1) << level_shift(levels)) - 1)) == 0 && !overflow.empty())
+		{
+			cascade(overflow, levels);
+		}
+
+		for (unsigned int level = levels - 1; level != 0; --level)
+		{
+			if ((tick & ((static_cast<tick_type>(1) << level_shift(level)) - 1)) == 0)
+			{
+				bucket_type &bucket = buckets[(level * slot_count) + static_cast<size_type>((tick >> level_shift(level)) & slot_mask)];
+
+				if (!bucket.empty()) cascade(bucket, level);
+			}
+		}
+	}
+
+
+
+public:
+
+	explicit timer_wheel(const tick_type start_time = 0):
+		buckets(levels * slot_count),
+		active_count(0),
+		current_time(start_time)
+	{
+		for (unsigned int level = 0; level != levels + 1; ++level)
+		{
+			level_counts[level] = 0;
+		}
+	}
+
+
+
+	timer_wheel(const timer_wheel &source) = default;
+	timer_wheel & operator = (const timer_wheel &source) = default;
+
+
+
+	timer_wheel(timer_wheel &&source):
+		timer_wheel(source.current_time)
+	{
+		swap(source);
+	}
+
+
+
+	timer_wheel & operator = (timer_wheel &&source) PLF_NOEXCEPT
+	{
+		assert(&source != this);
+		swap(source);
+		return *this;
+	}
+
+
+
+	// Deadlines at or before time() fire on the next tick processed:
+	template<typename input_type>
+	timer_handle schedule(tick_type deadline, input_type &&value)
+	{
+		if (deadline <= current_time) deadline = current_time + 1;
+
+		const size_type index = acquire_timer();
+		const unsigned int level = level_of(deadline);
+
+		#ifdef PLF_EXCEPTIONS_SUPPORT
+			try
+			{
+				bucket_for(level, deadline).emplace(deadline, index, timers[index].generation, std::forward<input_type>(value));
+			}
+			catch (...)
+			{
+				free_timers.push_back(index);
+				throw;
+			}
+		#else
+			bucket_for(level, deadline).emplace(deadline, index, timers[index].generation, std::forward<input_type>(value));
+		#endif
+
+		timers[index].pending = true;
+		++level_counts[level];
+		++active_count;
+		return timer_handle(index, timers[index].generation);
+	}
+
+
+
+	template<typename input_type>
+	timer_handle schedule_after(const tick_type delay, input_type &&value)
+	{
+		return schedule(current_time + delay, std::forward<input_type>(value));
+	}
+
+
+
+	// Returns false if the timer has already fired or been cancelled:
+	bool cancel(const timer_handle handle) PLF_NOEXCEPT
+	{
+		if (!pending(handle)) return false;
+
+		release_timer(handle.index);
+		return true;
+	}
+
+
+
+	bool pending(const timer_handle handle) const PLF_NOEXCEPT
+	{
+		return handle.index < timers.size() && timers[handle.index].pending && timers[handle.index].generation == handle.generation;
+	}
+
+
+
+	// Process all ticks after time() up to and including 'to', calling function(value &) for each timer which expires, in deadline order. Returns the number of timers expired.
+	// function may schedule or cancel timers, but must not call advance(). If function throws, time() is left before the tick in progress and the tick's remaining timers stay scheduled.
+	template <class function_type>
+	size_type advance(const tick_type to, function_type function)
+	{
+		assert(to >= current_time);
+		size_type fired = 0;
+
+		while (current_time < to)
+		{
+			if (stored_count() == 0)
+			{
+				current_time = to;
+				break;
+			}
+
+			// If the lowest n levels are empty, nothing can happen until the next tick at which level n cascades:
+			unsigned int empty_levels = 0;
+
+			while (empty_levels != levels && level_counts[empty_levels] == 0)
+			{
+				++empty_levels;
+			}
+
+			tick_type next = current_time + 1;
+
+			if (empty_levels != 0)
+			{
+				next = (current_time | ((static_cast<tick_type>(1) << level_shift(empty_levels)) - 1)) + 1;
+
+				if (next > to)
+				{
+					current_time = to;
+					break;
+				}
+			}
+
+			current_time = next;
+			process_tick(next);
+			fired += drain(next, function);
+		}
+
+		return fired;
+	}
+
+
+
+	tick_type time() const PLF_NOEXCEPT
+	{
+		return current_time;
+	}
+
+
+
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() const PLF_NOEXCEPT
+	{
+		return active_count == 0;
+	}
+
+
+
+	// Number of pending timers:
+	size_type size() const PLF_NOEXCEPT
+	{
+		return active_count;
+	}
+
+
+
+	size_type memory() const PLF_NOEXCEPT
+	{
+		size_type memory_use = sizeof(*this) + (buckets.capacity() * sizeof(bucket_type)) + (timers.capacity() * sizeof(timer_record)) + (free_timers.capacity() * sizeof(size_type)) + (overflow.memory() - sizeof(bucket_type)) + (spare.memory() - sizeof(bucket_type));
+
+		for (typename std::vector<bucket_type>::const_iterator current = buckets.begin(); current != buckets.end(); ++current)
+		{
+			memory_use += current->memory() - sizeof(bucket_type);
+		}
+
+		return memory_use;
+	}
+
+
+
+	// Cancel all timers. time() is unchanged:
+	void clear() PLF_NOEXCEPT
+	{
+		for (typename std::vector<bucket_type>::iterator current = buckets.begin(); current != buckets.end(); ++current)
+		{
+			current->clear();
+		}
+
+		overflow.clear();
+		spare.clear();
+
+		for (size_type index = 0; index != timers.size(); ++index)
+		{
+			if (timers[index].pending) release_timer(index);
+		}
+
+		for (unsigned int level = 0; level != levels + 1; ++level)
+		{
+			level_counts[level] = 0;
+		}
+	}
+
+
+
+	// Release memory held by empty buckets and unused groups:
+	void trim() PLF_NOEXCEPT
+	{
+		for (typename std::vector<bucket_type>::iterator current = buckets.begin(); current != buckets.end(); ++current)
+		{
+			if (current->empty())
+			{
+				current->clear();
+			}
+			else
+			{
+				current->trim();
+			}
+		}
+
+		overflow.trim();
+		spare.clear();
+	}
+
+
+
+	void swap(timer_wheel &source) PLF_NOEXCEPT
+	{
+		buckets.swap(source.buckets);
+		overflow.swap(source.overflow);
+		spare.swap(source.spare);
+		timers.swap(source.timers);
+		free_timers.swap(source.free_timers);
+
+		for (unsigned int level = 0; level != levels + 1; ++level)
+		{
+			std::swap(level_counts[level], source.level_counts[level]);
+		}
+
+		std::swap(active_count, source.active_count);
+		std::swap(current_time, source.current_time);
+	}
+}; // timer_wheel
+
+
+} // plf namespace
+
+
+
+namespace std
+{
+
+template <class element_type, unsigned int slot_bits, unsigned int levels, plf::priority priority>
+void swap (plf::timer_wheel<element_type, slot_bits, levels, priority> &a, plf::timer_wheel<element_type, slot_bits, levels, priority> &b) PLF_NOEXCEPT
+{
+	a.swap(b);
+}
+
+}
+
+
+#endif // PLF_VARIADICS_SUPPORT etc
+
+
+#ifdef PLF_TIMER_WHEEL_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_TIMER_WHEEL_H
@@ -0,0 +1,271 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+#include <algorithm> // std::sort
+#include <memory> // unique_ptr
+#include <stdexcept> // runtime_error
+#include <utility> // std::pair
+#include <vector> // reference model
+
+#include "plf_timer_wheel.h"
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+	struct reference_timer
+	{
+		unsigned long long	deadline;
+		unsigned int			id;
+		bool						pending;
+	};
+
+
+
+	// Schedules, cancels and advances a wheel and a brute-force model with the same random sequence, returning false on the first mismatch:
+	template <class wheel_type>
+	bool compare_with_reference(wheel_type &wheel, unsigned int seed, const unsigned long long max_delay, const unsigned int operations)
+	{
+		std::vector<reference_timer> reference;
+		std::vector<typename wheel_type::timer_handle> handles;
+		std::vector<std::pair<unsigned long long, unsigned int> > fired, expected;
+
+		for (unsigned int counter = 0; counter != operations; ++counter)
+		{
+			seed = seed * 1103515245 + 12345;
+			const unsigned int choice = (seed >> 16) % 10;
+			seed = seed * 1103515245 + 12345;
+			const unsigned long long random = seed >> 4;
+
+			if (choice < 6)
+			{
+				unsigned long long deadline = wheel.time() + (random % max_delay);
+				const unsigned int id = static_cast<unsigned int>(reference.size());
+				handles.push_back(wheel.schedule(deadline, id));
+
+				if (deadline <= wheel.time()) deadline = wheel.time() + 1;
+
+				const reference_timer timer = {deadline, id, true};
+				reference.push_back(timer);
+			}
+			else if (choice < 8)
+			{
+				if (reference.empty()) continue;
+
+				const unsigned int id = static_cast<unsigned int>(random % reference.size());
+
+				if (wheel.cancel(handles[id]) != reference[id].pending) return false;
+
+				reference[id].pending = false;
+			}
+			else
+			{
+				const unsigned long long to = wheel.time() + (random % (max_delay / 4 + 1));
+				fired.clear();
+				expected.clear();
+
+				wheel.advance(to, [&] (unsigned int &id) { fired.push_back(std::make_pair(wheel.time(), id)); });
+
+				for (typename std::vector<reference_timer>::iterator timer = reference.begin(); timer != reference.end(); ++timer)
+				{
+					if (timer->pending && timer->deadline <= to)
+					{
+						expected.push_back(std::make_pair(timer->deadline, timer->id));
+						timer->pending = false;
+					}
+				}
+
+				for (std::size_t index = 1; index < fired.size(); ++index)
+				{
+					if (fired[index].first < fired[index - 1].first) return false; // deadline order
+				}
+
+				std::sort(fired.begin(), fired.end());
+				std::sort(expected.begin(), expected.end());
+
+				if (fired != expected || wheel.time() != to) return false;
+			}
+
+			unsigned int pending = 0;
+
+			for (typename std::vector<reference_timer>::iterator timer = reference.begin(); timer != reference.end(); ++timer)
+			{
+				pending += timer->pending;
+			}
+
+			if (wheel.size() != pending) return false;
+		}
+
+		return true;
+	}
+#endif
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	#if defined(PLF_VARIADICS_SUPPORT) && defined(PLF_MOVE_SEMANTICS_SUPPORT) && defined(PLF_TYPE_TRAITS_SUPPORT)
+		unsigned int looper = 0;
+
+		while (++looper != 50)
+		{
+			{
+				title1("Test basics");
+
+				timer_wheel<int> wheel;
+				int total = 0;
+
+				failpass("Empty test", wheel.empty() && wheel.time() == 0 && wheel.advance(1000, [&] (int &value) { total += value; }) == 0 && wheel.time() == 1000);
+
+				wheel.schedule(1005, 1);
+				wheel.schedule_after(10, 2);
+				timer_wheel<int>::timer_handle handle = wheel.schedule(1300, 4);
+				wheel.schedule(70000, 8);
+				wheel.schedule(500, 16);
+
+				failpass("Size test", wheel.size() == 5 && wheel.pending(handle));
+
+				failpass("Past deadline test", wheel.advance(1001, [&] (int &value) { total += value; }) == 1 && total == 16);
+				failpass("Level 0 expiry test", wheel.advance(1010, [&] (int &value) { total += value; }) == 2 && total == 19);
+				failpass("Cancel test", wheel.cancel(handle) && !wheel.pending(handle) && !wheel.cancel(handle) && wheel.size() == 1);
+
+				unsigned long long fired_at = 0;
+
+				failpass("Cascade expiry test", wheel.advance(100000, [&] (int &value) { total += value; fired_at = wheel.time(); }) == 1 && total == 27 && fired_at == 70000 && wheel.empty());
+
+				handle = wheel.schedule_after(1, 32);
+
+				failpass("Stale handle test", !wheel.cancel(timer_wheel<int>::timer_handle()) && wheel.pending(handle));
+
+				wheel.clear();
+
+				failpass("Clear test", wheel.empty() && !wheel.pending(handle) && wheel.advance(200000, [&] (int &value) { total += value; }) == 0);
+			}
+
+
+			{
+				title2("Reference comparison tests");
+
+				timer_wheel<unsigned int> wheel;
+
+				failpass("Default geometry test", compare_with_reference(wheel, looper, 100000, 4000));
+
+				timer_wheel<unsigned int, 4, 3> small_wheel; // 4096-tick range, so long deadlines use the overflow bucket
+
+				failpass("Overflow bucket test", compare_with_reference(small_wheel, looper * 7, 20000, 4000));
+
+				timer_wheel<unsigned int, 2, 2> tiny_wheel(123456);
+
+				failpass("Tiny geometry test", compare_with_reference(tiny_wheel, looper * 13, 300, 4000));
+			}
+
+
+			{
+				title2("Bulk expiry tests");
+
+				timer_wheel<int, 6, 3> wheel;
+				int total = 0;
+
+				for (int temp = 0; temp != 100000; ++temp)
+				{
+					wheel.schedule(50000, temp & 1); // all in one bucket, cascaded whole
+				}
+
+				failpass("Bulk cascade test", wheel.advance(49999, [&] (int &value) { total += value; }) == 0 && wheel.size() == 100000);
+				failpass("Bulk drain test", wheel.advance(50000, [&] (int &value) { total += value; }) == 100000 && total == 50000 && wheel.empty());
+
+				wheel.schedule_after(5, 1);
+				int rescheduled = 0;
+
+				failpass("Reschedule from callback test", wheel.advance(wheel.time() + 100, [&] (int &value) { if (++rescheduled != 10) wheel.schedule_after(3, value); }) == 10);
+
+				timer_wheel<int, 6, 3> copy(wheel);
+				copy.schedule_after(1, 1);
+				timer_wheel<int, 6, 3> moved(std::move(copy));
+
+				failpass("Copy/move test", moved.size() == 1 && copy.empty() && wheel.empty());
+
+				swap(moved, wheel);
+
+				failpass("Swap test", wheel.size() == 1 && moved.empty());
+
+				wheel.trim();
+
+				failpass("Trim test", wheel.advance(wheel.time() + 1, [] (int &) {}) == 1);
+			}
+
+
+			#if __cplusplus >= 201703L // plf::queue::swap needs copyable elements before C++17
+			{
+				title2("Move-only and exception tests");
+
+				timer_wheel<std::unique_ptr<int> > wheel;
+				int total = 0;
+
+				for (int temp = 0; temp != 10; ++temp)
+				{
+					wheel.schedule(100, std::unique_ptr<int>(new int(temp)));
+				}
+
+				bool thrown = false;
+
+				try
+				{
+					wheel.advance(200, [&] (std::unique_ptr<int> &value) { if (*value == 4) throw std::runtime_error("test"); total += *value; });
+				}
+				catch (std::runtime_error &)
+				{
+					thrown = true;
+				}
+
+				failpass("Exception rewind test", thrown && total == 6 && wheel.time() == 99 && wheel.size() == 5);
+
+				std::unique_ptr<int> taken;
+
+				failpass("Resume after exception test", wheel.advance(200, [&] (std::unique_ptr<int> &value) { total += *value; taken = std::move(value); }) == 5 && total == 41 && *taken == 9 && wheel.time() == 200);
+			}
+			#endif
+		}
+	#endif
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}
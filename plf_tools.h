@@ -65,6 +65,7 @@
 			#if _MSVC_LANG >= 201703L
 				#undef PLF_CONSTEXPR
 				#define PLF_CONSTEXPR constexpr
+				#define PLF_OPTIONAL_SUPPORT
 			#endif
 
 			#if _MSVC_LANG >= 202002L && _MSC_VER >= 1929
@@ -189,6 +190,7 @@
 			#undef PLF_CONSTEXPR
 			#define PLF_CONSTEXPR constexpr
 			#define PLF_VOIDT_SUPPORT
+			#define PLF_OPTIONAL_SUPPORT
 		#endif
 
 		#if __cplusplus >= 202001L && ((((defined(__clang__) && __clang_major__ >= 15) || (defined(__GNUC__) && (__GNUC__ >= 12))) && ((defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 15) || (defined(__GLIBCXX__) &&	_GLIBCXX_RELEASE >= 12))) || (!defined(__clang__) && !defined(__GNUC__)))
@@ -568,6 +570,8 @@
 #if defined(PLF_INCLUDE_UNINITIALIZED_TOOLS) && !defined(PLF_UNINITIALIZED_TOOLS)
 	#define PLF_UNINITIALIZED_TOOLS
 
+	#include <memory> // std::uninitialized_copy, std::uninitialized_fill_n
+
 	#if defined(PLF_TYPE_TRAITS_SUPPORT) && defined(PLF_VOIDT_SUPPORT)
 		#include <type_traits> // void_t, false_type
 		#include <utility> // declval
@@ -588,6 +592,24 @@
 			// Tests for dummy type int:
 			template<typename allocator_type>
 			struct allocator_has_construct< allocator_type, std::void_t<decltype(std::declval<allocator_type&>().construct(std::declval<int*>(), std::declval<int>()))> > : std::true_type {};
+
+
+
+			// Template to check whether an allocator can report the usable size of an allocation (in bytes) for a given request size, eg. the size class it will actually be served from:
+			template<typename allocator_type, typename = std::void_t<>>
+			struct allocator_has_good_size : std::false_type {};
+
+			template<typename allocator_type>
+			struct allocator_has_good_size< allocator_type, std::void_t<decltype(std::declval<const allocator_type&>().good_size(std::declval<std::size_t>()))> > : std::true_type {};
+
+
+
+			// Template to check whether an allocator can release the memory pages of an allocation back to the OS without deallocating it, via discard(pointer, size):
+			template<typename allocator_type, typename = std::void_t<>>
+			struct allocator_has_discard : std::false_type {};
+
+			template<typename allocator_type>
+			struct allocator_has_discard< allocator_type, std::void_t<decltype(std::declval<allocator_type&>().discard(std::declval<typename std::allocator_traits<allocator_type>::pointer>(), std::declval<std::size_t>()))> > : std::true_type {};
 		#endif
 
 
@@ -1,3 +1,4 @@
+#undef PLF_COMPILER_DEFINES // So that subsequently-included plf headers redefine the macros below
 
 #undef PLF_CONSTRUCT_ELEMENT
 #undef PLF_DEFAULT_SUPPORT
@@ -19,6 +20,7 @@
 #undef PLF_CPP11_SUPPORT
 #undef PLF_CONSTEVAL_SUPPORT
 #undef PLF_VOIDT_SUPPORT
+#undef PLF_OPTIONAL_SUPPORT
 
 
 #undef PLF_CONSTRUCT
@@ -0,0 +1,350 @@
+// Copyright (c) 2026, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// zLib license (https://www.zlib.net/zlib_license.html):
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// 	claim that you wrote the original software. If you use this software
+// 	in a product, an acknowledgement in the product documentation would be
+// 	appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+// 	misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_WATERMARK_QUEUE_H
+#define PLF_WATERMARK_QUEUE_H
+
+#ifndef PLF_COMPILER_DEFINES
+	#define PLF_WATERMARK_QUEUE_DEFINES
+#endif
+
+#define PLF_INCLUDE_TOOLS
+#include "plf_tools.h"
+
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <limits> // std::numeric_limits
+#include <memory> // std::allocator
+
+#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+	#include <utility> // std::move, std::forward
+#endif
+
+#include "plf_queue.h"
+
+
+
+namespace plf
+{
+
+
+// Default handler for plf::watermark_queue - does nothing, so only the above_high_watermark() flag is maintained:
+struct null_watermark_handler
+{
+	void high_watermark_reached(const std::size_t) PLF_NOEXCEPT
+	{}
+
+	void low_watermark_reached(const std::size_t) PLF_NOEXCEPT
+	{}
+};
+
+
+
+// plf::watermark_queue is a plf::queue with high and low watermarks for back-pressure. When a push brings the size up to the high watermark, handler.high_watermark_reached(size) is called and above_high_watermark() becomes true. When a pop (or clear) subsequently brings the size down to the low watermark, handler.low_watermark_reached(size) is called and the flag is cleared. Each is called once per crossing, not on every push or pop while above or below.
+// The checks sit in the wrapper's push/emplace/pop rather than in plf::queue itself, so a plain plf::queue pays nothing for them. The handler is stored via empty-base-class optimisation, and with the default null_watermark_handler the calls compile away, leaving a compare and branch against the flag.
+// Callbacks run synchronously inside the push or pop which crossed the watermark - they should be short, eg. setting an atomic flag which producers check.
+
+template <class element_type, class handler_type = plf::null_watermark_handler, plf::priority priority = plf::memory_use, class allocator_type = std::allocator<element_type> >
+class watermark_queue : private handler_type // Empty base class optimisation
+{
+public:
+	typedef plf::queue<element_type, priority, allocator_type>	queue_type;
+	typedef element_type													value_type;
+	typedef typename queue_type::size_type							size_type;
+	typedef typename queue_type::reference							reference;
+	typedef typename queue_type::const_reference					const_reference;
+
+private:
+	queue_type		elements;
+	size_type		high_mark, low_mark;
+	bool				above_high;
+
+
+
+	void check_high_watermark()
+	{
+		if (!above_high && elements.size() >= high_mark)
+		{
+			above_high = true;
+			static_cast<handler_type &>(*this).high_watermark_reached(elements.size());
+		}
+	}
+
+
+
+	void check_low_watermark()
+	{
+		if (above_high && elements.size() <= low_mark)
+		{
+			above_high = false;
+			static_cast<handler_type &>(*this).low_watermark_reached(elements.size());
+		}
+	}
+
+
+
+public:
+
+	// Without watermarks - the high watermark is never reached until set_watermarks() is called:
+	watermark_queue():
+		high_mark(std::numeric_limits<size_type>::max()),
+		low_mark(0),
+		above_high(false)
+	{}
+
+
+
+	watermark_queue(const size_type high_watermark, const size_type low_watermark, const handler_type &handler = handler_type()):
+		handler_type(handler),
+		high_mark(high_watermark),
+		low_mark(low_watermark),
+		above_high(false)
+	{
+		assert(low_watermark < high_watermark);
+	}
+
+
+
+	// As above, with the underlying queue's block capacity limits:
+	watermark_queue(const size_type high_watermark, const size_type low_watermark, const size_type min, const size_type max, const handler_type &handler = handler_type()):
+		handler_type(handler),
+		elements(min, max),
+		high_mark(high_watermark),
+		low_mark(low_watermark),
+		above_high(false)
+	{
+		assert(low_watermark < high_watermark);
+	}
+
+
+
+	void push(const element_type &element)
+	{
+		elements.push(element);
+		check_high_watermark();
+	}
+
+
+
+	#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+		void push(element_type &&element)
+		{
+			elements.push(std::move(element));
+			check_high_watermark();
+		}
+	#endif
+
+
+
+	#ifdef PLF_VARIADICS_SUPPORT
+		template<typename... arguments>
+		void emplace(arguments &&... parameters)
+		{
+			elements.emplace(std::forward<arguments>(parameters)...);
+			check_high_watermark();
+		}
+	#endif
+
+
+
+	reference front() const // Exception may occur if queue is empty in release mode
+	{
+		return elements.front();
+	}
+
+
+
+	reference back() const // Exception may occur if queue is empty in release mode
+	{
+		return elements.back();
+	}
+
+
+
+	void pop() // Exception may occur if queue is empty
+	{
+		elements.pop();
+		check_low_watermark();
+	}
+
+
+
+	bool try_pop(element_type &destination)
+	{
+		if (!elements.try_pop(destination)) return false;
+
+		check_low_watermark();
+		return true;
+	}
+
+
+
+	// Changes the watermarks without calling the handler. above_high_watermark() is recalculated from the current size:
+	void set_watermarks(const size_type high_watermark, const size_type low_watermark) PLF_NOEXCEPT
+	{
+		assert(low_watermark < high_watermark);
+		high_mark = high_watermark;
+		low_mark = low_watermark;
+		above_high = elements.size() >= high_mark;
+	}
+
+
+
+	size_type high_watermark() const PLF_NOEXCEPT
+	{
+		return high_mark;
+	}
+
+
+
+	size_type low_watermark() const PLF_NOEXCEPT
+	{
+		return low_mark;
+	}
+
+
+
+	// True from the push which reached the high watermark until the pop which reaches the low watermark:
+	bool above_high_watermark() const PLF_NOEXCEPT
+	{
+		return above_high;
+	}
+
+
+
+	handler_type & handler() PLF_NOEXCEPT
+	{
+		return static_cast<handler_type &>(*this);
+	}
+
+
+
+	const queue_type & underlying_queue() const PLF_NOEXCEPT
+	{
+		return elements;
+	}
+
+
+
+	#ifdef PLF_CPP20_SUPPORT
+		[[nodiscard]]
+	#endif
+	bool empty() const PLF_NOEXCEPT
+	{
+		return elements.empty();
+	}
+
+
+
+	size_type size() const PLF_NOEXCEPT
+	{
+		return elements.size();
+	}
+
+
+
+	size_type capacity() const PLF_NOEXCEPT
+	{
+		return elements.capacity();
+	}
+
+
+
+	size_type memory() const PLF_NOEXCEPT
+	{
+		return sizeof(*this) + (elements.memory() - sizeof(elements));
+	}
+
+
+
+	void reserve(const size_type reserve_amount)
+	{
+		elements.reserve(reserve_amount);
+	}
+
+
+
+	// Calls the low watermark handler if the queue was above the high watermark:
+	void clear()
+	{
+		elements.clear();
+		check_low_watermark();
+	}
+
+
+
+	void trim() PLF_NOEXCEPT
+	{
+		elements.trim();
+	}
+
+
+
+	void shrink_to_fit()
+	{
+		elements.shrink_to_fit();
+	}
+
+
+
+	// Swaps contents, watermarks and handlers:
+	void swap(watermark_queue &source)
+	{
+		elements.swap(source.elements);
+
+		handler_type swap_handler(static_cast<handler_type &>(*this));
+		static_cast<handler_type &>(*this) = static_cast<handler_type &>(source);
+		static_cast<handler_type &>(source) = swap_handler;
+
+		const size_type swap_high = high_mark, swap_low = low_mark;
+		const bool swap_above = above_high;
+		high_mark = source.high_mark;
+		low_mark = source.low_mark;
+		above_high = source.above_high;
+		source.high_mark = swap_high;
+		source.low_mark = swap_low;
+		source.above_high = swap_above;
+	}
+}; // watermark_queue
+
+
+} // plf namespace
+
+
+
+namespace std
+{
+
+template <class element_type, class handler_type, plf::priority priority, class allocator_type>
+void swap (plf::watermark_queue<element_type, handler_type, priority, allocator_type> &a, plf::watermark_queue<element_type, handler_type, priority, allocator_type> &b)
+{
+	a.swap(b);
+}
+
+}
+
+
+
+#ifdef PLF_WATERMARK_QUEUE_DEFINES
+	#include "plf_tools_undef.h"
+#endif
+
+#endif // PLF_WATERMARK_QUEUE_H
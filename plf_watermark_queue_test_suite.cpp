@@ -0,0 +1,185 @@
+#include "plf_tools.h"
+
+#include <cstdio> // log redirection
+#include <cstdlib> // abort
+#include <string> // std::string elements
+
+#include "plf_watermark_queue.h"
+
+
+
+
+void title1(const char *title_text)
+{
+	printf("\n\n\n*** %s ***\n", title_text);
+	printf("===========================================\n\n\n");
+}
+
+void title2(const char *title_text)
+{
+	printf("\n\n--- %s ---\n\n", title_text);
+}
+
+
+void failpass(const char *test_type, bool condition)
+{
+	printf("%s: ", test_type);
+
+	if (condition)
+	{
+		printf("Pass\n");
+	}
+	else
+	{
+		printf("Fail\n");
+		getchar();
+		abort();
+	}
+}
+
+
+
+struct counting_handler
+{
+	unsigned int high_calls, low_calls;
+	std::size_t last_high_size, last_low_size;
+
+	counting_handler(): high_calls(0), low_calls(0), last_high_size(0), last_low_size(0) {}
+
+	void high_watermark_reached(const std::size_t size)
+	{
+		++high_calls;
+		last_high_size = size;
+	}
+
+	void low_watermark_reached(const std::size_t size)
+	{
+		++low_calls;
+		last_low_size = size;
+	}
+};
+
+
+
+int main()
+{
+	freopen("error.log","w", stderr);
+
+	using namespace std;
+	using namespace plf;
+
+	unsigned int looper = 0;
+
+	while (++looper != 50)
+	{
+		{
+			title1("Test basics");
+
+			watermark_queue<int, counting_handler> w_queue(10, 3);
+
+			failpass("Empty test", w_queue.empty() && !w_queue.above_high_watermark() && w_queue.high_watermark() == 10 && w_queue.low_watermark() == 3);
+
+			for (int counter = 0; counter != 9; ++counter)
+			{
+				w_queue.push(counter);
+			}
+
+			failpass("Below high watermark test", w_queue.handler().high_calls == 0 && !w_queue.above_high_watermark());
+
+			w_queue.push(9);
+
+			failpass("High watermark crossing test", w_queue.handler().high_calls == 1 && w_queue.handler().last_high_size == 10 && w_queue.above_high_watermark());
+
+			for (int counter = 10; counter != 30; ++counter)
+			{
+				w_queue.push(counter);
+			}
+
+			failpass("Fires once per crossing test", w_queue.handler().high_calls == 1);
+
+			while (w_queue.size() != 4)
+			{
+				w_queue.pop();
+			}
+
+			failpass("Above low watermark test", w_queue.handler().low_calls == 0 && w_queue.above_high_watermark());
+
+			int value = 0;
+
+			failpass("Try pop test", w_queue.try_pop(value) && value == 26);
+
+			failpass("Low watermark crossing test", w_queue.handler().low_calls == 1 && w_queue.handler().last_low_size == 3 && !w_queue.above_high_watermark());
+
+			for (int counter = 0; counter != 6; ++counter)
+			{
+				w_queue.push(counter);
+			}
+
+			failpass("Hysteresis test", w_queue.size() == 9 && w_queue.handler().high_calls == 1);
+
+			w_queue.push(6);
+
+			failpass("Second high crossing test", w_queue.handler().high_calls == 2);
+
+			w_queue.clear();
+
+			failpass("Clear crosses low watermark test", w_queue.handler().low_calls == 2 && w_queue.handler().last_low_size == 0 && w_queue.empty());
+
+			w_queue.clear();
+
+			failpass("Clear below low watermark test", w_queue.handler().low_calls == 2);
+		}
+
+
+		{
+			title2("Reconfiguration tests");
+
+			watermark_queue<std::string> w_queue;
+
+			for (unsigned int counter = 0; counter != 1000; ++counter)
+			{
+				w_queue.push(std::string(counter % 20, 'a'));
+			}
+
+			failpass("No watermarks test", !w_queue.above_high_watermark());
+
+			w_queue.set_watermarks(500, 100);
+
+			failpass("Set watermarks recalculates flag test", w_queue.above_high_watermark());
+
+			while (w_queue.size() > 100)
+			{
+				w_queue.pop();
+			}
+
+			failpass("Flag cleared at low watermark test", !w_queue.above_high_watermark() && w_queue.front() == std::string(900 % 20, 'a'));
+
+			#ifdef PLF_VARIADICS_SUPPORT
+				w_queue.set_watermarks(102, 101);
+				w_queue.emplace(3, 'b');
+				w_queue.emplace(4, 'b');
+
+				failpass("Emplace crossing test", w_queue.above_high_watermark() && w_queue.back() == "bbbb");
+			#endif
+
+			watermark_queue<std::string> w_queue2(5, 1);
+			w_queue2.push("x");
+			w_queue.swap(w_queue2);
+
+			failpass("Swap test", w_queue.size() == 1 && w_queue.high_watermark() == 5 && w_queue2.size() >= 100 && w_queue2.low_watermark() >= 100);
+
+			w_queue.reserve(1000);
+
+			failpass("Reserve test", w_queue.capacity() >= 1000 && w_queue.memory() >= w_queue.underlying_queue().memory());
+
+			w_queue.trim();
+
+			failpass("Trim test", w_queue.capacity() < 1000 && w_queue.size() == 1 && w_queue.front() == "x");
+		}
+	}
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	getchar();
+
+	return 0;
+}